@@ -557,6 +557,8 @@ void IntersectEditor::saveUserSettings (float scale, const juce::String& themeNa
     if (stemFolder != juce::File())
         content << "stemModelFolder: " << stemFolder.getFullPathName() << "\n";
     content << "stemComputeDevice: " << stemComputeDeviceToString (processor.getStemComputeDevice()) << "\n";
+    content << "retainSourcePcm: " << (processor.isRetainingSourcePcm() ? "true" : "false") << "\n";
+    content << "regionCacheMB: " << (int) (processor.getDecodedRegionCacheCapacity() / (1024 * 1024)) << "\n";
     file.replaceWithText (content);
 }
 
@@ -612,6 +614,16 @@ void IntersectEditor::loadUserSettings()
                 processor.setStemComputeDevice (
                     stemComputeDeviceFromString (line.fromFirstOccurrenceOf (":", false, false).trim()));
             }
+            else if (line.startsWith ("retainSourcePcm:"))
+            {
+                auto val = line.fromFirstOccurrenceOf (":", false, false).trim();
+                processor.setRetainSourcePcm (val == "true");
+            }
+            else if (line.startsWith ("regionCacheMB:"))
+            {
+                int val = line.fromFirstOccurrenceOf (":", false, false).trim().getIntValue();
+                processor.setDecodedRegionCacheCapacity ((size_t) juce::jlimit (0, 4096, val) * 1024 * 1024);
+            }
             else if (line.startsWith ("stemModelPath:"))
             {
                 auto legacyPath = juce::File (line.fromFirstOccurrenceOf (":", false, false).trim());
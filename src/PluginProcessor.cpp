@@ -2,7 +2,7 @@
 #include "PluginEditor.h"
 #include "Constants.h"
 #include "audio/GrainEngine.h"
-#include "audio/AudioAnalysis.h"
+#include "audio/SessionAutoChop.h"
 #include <cmath>
 #include <cstring>
 #include <functional>
@@ -17,19 +17,24 @@ public:
                                           std::unique_ptr<SampleData::DecodedSample>)>;
     using FailureFn = std::function<void (int, IntersectProcessor::LoadKind, const juce::File&)>;
 
+    // With appendBase set, only files are decoded and then spliced after it.
     SampleDecodeJob (std::vector<juce::File> sourceFiles,
                      std::vector<int> sourceSampleIds,
                      double targetRate, int loadToken,
                      IntersectProcessor::LoadKind kind,
-                     SuccessFn onSuccessIn, FailureFn onFailureIn)
+                     SampleData::DecodeOptions options,
+                     SuccessFn onSuccessIn, FailureFn onFailureIn,
+                     SampleData::SnapshotPtr appendBaseIn = {})
         : juce::ThreadPoolJob ("SampleDecodeJob"),
           files (std::move (sourceFiles)),
           sampleIds (std::move (sourceSampleIds)),
           sampleRate (targetRate),
           token (loadToken),
           loadKind (kind),
+          decodeOptions (std::move (options)),
           onSuccess (std::move (onSuccessIn)),
-          onFailure (std::move (onFailureIn))
+          onFailure (std::move (onFailureIn)),
+          appendBase (std::move (appendBaseIn))
     {
     }
 
@@ -38,10 +43,24 @@ public:
         if (files.empty())
             return jobHasFinished;
 
-        auto decoded = SampleData::decodeFromFiles (files, sampleRate, &sampleIds);
+        auto options = decodeOptions;
+        options.shouldCancel = [this, superseded = decodeOptions.shouldCancel]
+        {
+            return shouldExit() || (superseded && superseded());
+        };
+
+        auto decoded = SampleData::decodeFromFiles (files, sampleRate, &sampleIds, options);
         if (shouldExit())
             return jobHasFinished;
 
+        if (decoded != nullptr && appendBase != nullptr)
+        {
+            decoded = SampleData::appendToSession (*appendBase, *decoded);
+            appendBase.reset();
+            if (shouldExit())
+                return jobHasFinished;
+        }
+
         if (decoded != nullptr)
             onSuccess (token, loadKind, std::move (decoded));
         else
@@ -55,8 +74,128 @@ private:
     double sampleRate = 44100.0;
     int token = 0;
     IntersectProcessor::LoadKind loadKind = IntersectProcessor::LoadKindReplace;
+    SampleData::DecodeOptions decodeOptions;
     SuccessFn onSuccess;
     FailureFn onFailure;
+    SampleData::SnapshotPtr appendBase;
+};
+
+// Rebuilds the session buffer from the current one minus deleted samples. The
+// result goes through the same completed-load handoff as a file decode.
+class SessionRebuildJob final : public juce::ThreadPoolJob
+{
+public:
+    SessionRebuildJob (SampleData::SnapshotPtr sourceIn,
+                       std::vector<SampleData::SessionSample> remainingSamples,
+                       int loadToken,
+                       SampleDecodeJob::SuccessFn onSuccessIn)
+        : juce::ThreadPoolJob ("SessionRebuildJob"),
+          source (std::move (sourceIn)),
+          remaining (std::move (remainingSamples)),
+          token (loadToken),
+          onSuccess (std::move (onSuccessIn))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        if (source == nullptr || remaining.empty())
+            return jobHasFinished;
+
+        auto rebuilt = SampleData::rebuildWithSessionSamples (*source, remaining);
+        source.reset();   // drop the old buffer here if nothing else holds it
+        if (shouldExit())
+            return jobHasFinished;
+
+        onSuccess (token, IntersectProcessor::LoadKindPreserveSlices, std::move (rebuilt));
+        return jobHasFinished;
+    }
+
+private:
+    SampleData::SnapshotPtr source;
+    std::vector<SampleData::SessionSample> remaining;
+    int token = 0;
+    SampleDecodeJob::SuccessFn onSuccess;
+};
+
+// Rebuilds the session at a new rate from its retained source-rate audio, so a
+// host rate change does not re-read the files.
+class SessionResampleJob final : public juce::ThreadPoolJob
+{
+public:
+    SessionResampleJob (SampleData::SnapshotPtr sourceIn, double targetRate,
+                        int loadToken, IntersectProcessor::LoadKind kind,
+                        SampleDecodeJob::SuccessFn onSuccessIn)
+        : juce::ThreadPoolJob ("SessionResampleJob"),
+          source (std::move (sourceIn)),
+          sampleRate (targetRate),
+          token (loadToken),
+          loadKind (kind),
+          onSuccess (std::move (onSuccessIn))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        if (source == nullptr)
+            return jobHasFinished;
+
+        auto resampled = SampleData::resampleFromSource (*source, sampleRate);
+        source.reset();
+        if (resampled == nullptr || shouldExit())
+            return jobHasFinished;
+
+        onSuccess (token, loadKind, std::move (resampled));
+        return jobHasFinished;
+    }
+
+private:
+    SampleData::SnapshotPtr source;
+    double sampleRate = 44100.0;
+    int token = 0;
+    IntersectProcessor::LoadKind loadKind = IntersectProcessor::LoadKindRelink;
+    SampleDecodeJob::SuccessFn onSuccess;
+};
+
+// Finds whole-session auto chop boundaries, analysing samples in parallel on
+// the helper pool.
+class SessionAutoChopJob final : public juce::ThreadPoolJob
+{
+public:
+    using DoneFn = std::function<void (std::vector<int> boundaries)>;
+
+    SessionAutoChopJob (SampleData::SnapshotPtr sessionIn, const SessionAutoChop::Settings& settingsIn,
+                        const SessionOdfCache& cache, juce::ThreadPool& helpers, DoneFn onDoneIn)
+        : juce::ThreadPoolJob ("SessionAutoChopJob"),
+          session (std::move (sessionIn)),
+          settings (settingsIn),
+          odfCache (cache),
+          pool (helpers),
+          onDone (std::move (onDoneIn))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        if (session == nullptr)
+            return jobHasFinished;
+
+        auto boundaries = SessionAutoChop::findBoundaries (*session, settings, &odfCache, &pool,
+                                                           [this] { return shouldExit(); });
+        session.reset();
+        if (shouldExit())
+            return jobHasFinished;
+
+        onDone (std::move (boundaries));
+        return jobHasFinished;
+    }
+
+private:
+    SampleData::SnapshotPtr session;
+    SessionAutoChop::Settings settings;
+    const SessionOdfCache& odfCache;
+    juce::ThreadPool& pool;
+    DoneFn onDone;
 };
 
 static constexpr uint64_t kValidLockMask =
@@ -207,6 +346,7 @@ static bool isCriticalCommand (IntersectProcessor::CommandType type)
         case IntersectProcessor::CmdDuplicateSlice:
         case IntersectProcessor::CmdSplitSlice:
         case IntersectProcessor::CmdTransientChop:
+        case IntersectProcessor::CmdAutoChopSession:
         case IntersectProcessor::CmdRelinkFile:
         case IntersectProcessor::CmdUndo:
         case IntersectProcessor::CmdRedo:
@@ -315,6 +455,7 @@ VoiceStartParams makeVoiceStartParams (const GlobalParamSnapshot& globals,
     params.globalFilterEnvReleaseSec = globals.filterEnvReleaseSec;
     params.globalFilterEnvAmount = globals.filterEnvAmount;
     params.globalCrossfadePct = globals.crossfadePct;
+    params.freezeStretch = globals.freezeStretch;
     params.rootNote = globals.rootNote;
     return params;
 }
@@ -340,6 +481,9 @@ IntersectProcessor::IntersectProcessor()
                           .withOutput ("Out 16", juce::AudioChannelSet::stereo(), false)),
       apvts (*this, nullptr, "PARAMETERS", ParamLayout::createLayout())
 {
+    sampleData.setReclaimer (&reclaimer);
+    sampleData.setStreamer (&streamer);
+
     masterVolParam = apvts.getRawParameterValue (ParamIds::masterVolume);
     bpmParam       = apvts.getRawParameterValue (ParamIds::defaultBpm);
     pitchParam     = apvts.getRawParameterValue (ParamIds::defaultPitch);
@@ -382,12 +526,14 @@ IntersectProcessor::~IntersectProcessor()
 {
         cancelPendingUpdate();
 	    fileLoadPool.removeAllJobs (true, 5000);
+	    decodePool.removeAllJobs (true, 5000);
 	    auto* pending = completedLoadData.exchange (nullptr, std::memory_order_acq_rel);
 	    delete pending;
 	    auto* failed = completedLoadFailure.exchange (nullptr, std::memory_order_acq_rel);
 	    delete failed;
 	    auto* stemPending = pendingStemImport.exchange (nullptr, std::memory_order_acq_rel);
 	    delete stemPending;
+	    delete completedSessionChop.exchange (nullptr, std::memory_order_acq_rel);
 }
 
 GlobalParamSnapshot IntersectProcessor::loadGlobalParamSnapshot() const
@@ -485,9 +631,57 @@ const IntersectProcessor::UiStatusMessage& IntersectProcessor::getUiStatusMessag
 
 void IntersectProcessor::handleAsyncUpdate()
 {
+    handleSessionChopCompletionOnMessageThread();
     handleStemJobCompletionOnMessageThread();
 }
 
+void IntersectProcessor::startSessionAutoChop (float sensitivity, float minSliceLenMs)
+{
+    auto snapshot = sampleData.getSnapshot();
+    if (snapshot == nullptr || snapshot->partial || snapshot->sessionSamples.empty())
+        return;
+
+    SessionAutoChop::Settings settings;
+    settings.sensitivity = sensitivity;
+    settings.minSliceLenMs = minSliceLenMs;
+    settings.snapToZeroCrossing = snapToZeroCrossing.load();
+    settings.maxSlices = SliceManager::kMaxSlices;
+
+    // Queued behind any pending load; a session swapped in meanwhile makes the
+    // result stale, which the completion handler checks by generation.
+    const auto generation = snapshot->generation;
+    fileLoadPool.addJob (new SessionAutoChopJob (std::move (snapshot), settings, odfCache, decodePool,
+                                                 [this, generation] (std::vector<int> boundaries)
+                                                 {
+                                                     auto* result = new SessionChopResult { std::move (boundaries), generation };
+                                                     delete completedSessionChop.exchange (result, std::memory_order_acq_rel);
+                                                     triggerAsyncUpdate();
+                                                 }),
+                         true);
+}
+
+void IntersectProcessor::handleSessionChopCompletionOnMessageThread()
+{
+    std::unique_ptr<SessionChopResult> result (completedSessionChop.exchange (nullptr, std::memory_order_acq_rel));
+    if (result == nullptr)
+        return;
+
+    auto snapshot = sampleData.getSnapshot();
+    if (snapshot == nullptr || snapshot->generation != result->generation)
+    {
+        setUiStatusMessage ("Session changed - auto chop discarded", true);
+        return;
+    }
+
+    Command cmd;
+    cmd.type = CmdAutoChopSession;
+    cmd.intParam1 = (int) result->generation;
+    cmd.numPositions = juce::jmin ((int) result->boundaries.size(), (int) cmd.positions.size());
+    for (int i = 0; i < cmd.numPositions; ++i)
+        cmd.positions[(size_t) i] = result->boundaries[(size_t) i];
+    pushCommand (cmd);
+}
+
 void IntersectProcessor::handleStemJobCompletionOnMessageThread()
 {
     stemCompletionQueued.store (false, std::memory_order_release);
@@ -719,8 +913,11 @@ bool IntersectProcessor::isBusesLayoutSupported (const BusesLayout& layouts) con
 void IntersectProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
+    // Sizes the stretcher pool for the current voice count.
+    voicePool.setMaxActiveVoices ((int) maxVoicesParam->load());
     voicePool.prepareToPlay (sampleRate, samplesPerBlock);
     std::fill (std::begin (heldNotes), std::end (heldNotes), false);
+    filteredMidiScratch.ensureSize (4096);
 
     auto sampleSnap = sampleData.getSnapshot();
     if (sampleSnap != nullptr
@@ -736,6 +933,13 @@ void IntersectProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
                                             sampleData.getSourceNumFrames(),
                                             sampleData.getSourceSampleRate());
         }
+
+        if (SampleData::canResampleFromSource (*sampleSnap))
+        {
+            requestSessionResample (std::move (sampleSnap), LoadKindRelink);
+            return;
+        }
+
         std::vector<juce::File> files;
         std::vector<int> sampleIds;
         files.reserve (sampleSnap->sessionSamples.size());
@@ -751,8 +955,36 @@ void IntersectProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 
 void IntersectProcessor::releaseResources() {}
 
-int IntersectProcessor::requestSampleLoad (const std::vector<juce::File>& files, LoadKind kind,
-                                           const std::vector<int>* sampleIds)
+void IntersectProcessor::setDiskDecodeCacheEnabled (bool shouldCache, const juce::File& directory)
+{
+    const auto dir = directory != juce::File()
+                         ? directory
+                         : juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+                               .getChildFile ("INTERSECT")
+                               .getChildFile ("DecodeCache");
+
+    const juce::ScopedLock sl (diskDecodeCacheLock);
+    if (! shouldCache)
+        diskDecodeCache.reset();
+    else if (diskDecodeCache == nullptr || diskDecodeCache->getDirectory() != dir)
+        diskDecodeCache = std::make_shared<DiskDecodeCache> (dir, diskDecodeCacheCapacity);
+}
+
+bool IntersectProcessor::isDiskDecodeCacheEnabled() const
+{
+    const juce::ScopedLock sl (diskDecodeCacheLock);
+    return diskDecodeCache != nullptr;
+}
+
+void IntersectProcessor::setDiskDecodeCacheCapacity (juce::int64 bytes)
+{
+    const juce::ScopedLock sl (diskDecodeCacheLock);
+    diskDecodeCacheCapacity = bytes;
+    if (diskDecodeCache != nullptr)
+        diskDecodeCache->setCapacityBytes (bytes);
+}
+
+int IntersectProcessor::beginLoadRequest (LoadKind kind)
 {
     const int token = nextLoadToken.fetch_add (1, std::memory_order_relaxed) + 1;
     latestLoadToken.store (token, std::memory_order_release);
@@ -763,12 +995,49 @@ int IntersectProcessor::requestSampleLoad (const std::vector<juce::File>& files,
     else if (pendingSliceTimelineRemap.active.load (std::memory_order_acquire))
         pendingSliceTimelineRemap.expectedLoadToken.store (token, std::memory_order_release);
 
-    // Keep only the latest completed decode payload.
-    auto* oldDecoded = completedLoadData.exchange (nullptr, std::memory_order_acq_rel);
-    delete oldDecoded;
-    auto* oldFailure = completedLoadFailure.exchange (nullptr, std::memory_order_acq_rel);
-    delete oldFailure;
+    // Keep only the latest completed decode payload. This also runs on the audio
+    // thread (sample-rate retry), so the stale one is freed by the reclaimer.
+    reclaimer.retire (std::unique_ptr<SampleData::DecodedSample> (
+        completedLoadData.exchange (nullptr, std::memory_order_acq_rel)));
+    reclaimer.retire (std::unique_ptr<FailedLoadResult> (
+        completedLoadFailure.exchange (nullptr, std::memory_order_acq_rel)));
+
+    return token;
+}
+
+void IntersectProcessor::publishCompletedLoad (int token, LoadKind kind,
+                                               std::unique_ptr<SampleData::DecodedSample> decoded)
+{
+    if (token != latestLoadToken.load (std::memory_order_acquire))
+        return;
+
+    loadFilesTotal.store (0, std::memory_order_release);
+    streamer.setStreamedLoadPending (decoded != nullptr && decoded->stream != nullptr);
+    auto* old = completedLoadData.exchange (decoded.release(), std::memory_order_acq_rel);
+    delete old;
+    latestLoadKind.store ((int) kind, std::memory_order_release);
+}
+
+// Like publishCompletedLoad, for a progressive load's partial session: the
+// load is still running, so its progress stays up.
+void IntersectProcessor::publishPartialLoad (int token, std::unique_ptr<SampleData::DecodedSample> decoded)
+{
+    if (token != latestLoadToken.load (std::memory_order_acquire))
+        return;
+
+    auto* old = completedLoadData.exchange (decoded.release(), std::memory_order_acq_rel);
+    delete old;
+    markUiSnapshotDirty();
+}
 
+int IntersectProcessor::requestSampleLoad (const std::vector<juce::File>& files, LoadKind kind,
+                                           const std::vector<int>* sampleIds,
+                                           SampleData::SnapshotPtr appendBase)
+{
+    const int token = beginLoadRequest (kind);
+    loadFilesDone.store (0, std::memory_order_relaxed);
+    loadFilesTotal.store ((int) files.size(), std::memory_order_release);
+    markUiSnapshotDirty();
     if (files.empty())
         return token;
 
@@ -786,12 +1055,7 @@ int IntersectProcessor::requestSampleLoad (const std::vector<juce::File>& files,
     auto onSuccess = [this] (int finishedToken, LoadKind finishedKind,
                              std::unique_ptr<SampleData::DecodedSample> decoded)
     {
-        if (finishedToken != latestLoadToken.load (std::memory_order_acquire))
-            return;
-
-        auto* old = completedLoadData.exchange (decoded.release(), std::memory_order_acq_rel);
-        delete old;
-        latestLoadKind.store ((int) finishedKind, std::memory_order_release);
+        publishCompletedLoad (finishedToken, finishedKind, std::move (decoded));
     };
 
     auto onFailure = [this] (int finishedToken, LoadKind finishedKind, const juce::File& failedFile)
@@ -799,6 +1063,7 @@ int IntersectProcessor::requestSampleLoad (const std::vector<juce::File>& files,
         if (finishedToken != latestLoadToken.load (std::memory_order_acquire))
             return;
 
+        loadFilesTotal.store (0, std::memory_order_release);
         auto* payload = new FailedLoadResult();
         payload->token = finishedToken;
         payload->kind = finishedKind;
@@ -808,7 +1073,60 @@ int IntersectProcessor::requestSampleLoad (const std::vector<juce::File>& files,
         delete old;
     };
 
-    fileLoadPool.addJob (new SampleDecodeJob (files, copiedSampleIds, sr, token, kind, onSuccess, onFailure), true);
+    // Files decode in parallel on decodePool; the job itself stays on the
+    // single-threaded fileLoadPool so loads still complete in request order.
+    SampleData::DecodeOptions options;
+    options.cache = &regionCache.getObject();
+    options.pool = &decodePool;
+    options.retainSourcePcm = retainSourcePcm.load (std::memory_order_relaxed);
+    options.storage = getSampleStorage();
+    {
+        const juce::ScopedLock sl (diskDecodeCacheLock);
+        options.diskCache = diskDecodeCache;
+    }
+    if (streamingMode.load (std::memory_order_relaxed))
+        options.streamDirectory = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                                      .getChildFile ("INTERSECT")
+                                      .getChildFile ("Streams");
+    options.shouldCancel = [this, token]
+    {
+        return token != latestLoadToken.load (std::memory_order_acquire);
+    };
+    options.onFileDecoded = [this, token] (int filesDone, int filesTotal)
+    {
+        if (token != latestLoadToken.load (std::memory_order_acquire))
+            return;
+
+        loadFilesDone.store (filesDone, std::memory_order_relaxed);
+        loadFilesTotal.store (filesTotal, std::memory_order_release);
+        markUiSnapshotDirty();
+    };
+
+    // Fresh sessions play their leading files while the rest decode. Appends
+    // already have audio up, and streamed loads never hold a session in memory.
+    if (appendBase == nullptr && options.streamDirectory == juce::File())
+        options.onPartialDecoded = [this, token] (std::unique_ptr<SampleData::DecodedSample> partial)
+        {
+            publishPartialLoad (token, std::move (partial));
+        };
+
+    fileLoadPool.addJob (new SampleDecodeJob (files, copiedSampleIds, sr, token, kind, std::move (options),
+                                              onSuccess, onFailure, std::move (appendBase)), true);
+    return token;
+}
+
+int IntersectProcessor::requestSessionResample (SampleData::SnapshotPtr source, LoadKind kind)
+{
+    const int token = beginLoadRequest (kind);
+    const double sr = currentSampleRate > 0.0 ? currentSampleRate : 44100.0;
+
+    auto onSuccess = [this] (int finishedToken, LoadKind finishedKind,
+                             std::unique_ptr<SampleData::DecodedSample> decoded)
+    {
+        publishCompletedLoad (finishedToken, finishedKind, std::move (decoded));
+    };
+
+    fileLoadPool.addJob (new SessionResampleJob (std::move (source), sr, token, kind, onSuccess), true);
     return token;
 }
 
@@ -828,7 +1146,8 @@ void IntersectProcessor::loadFilesAsync (const std::vector<juce::File>& files, b
 
     if (append)
     {
-        if (auto sampleSnap = sampleData.getSnapshot())
+        auto sampleSnap = sampleData.getSnapshot();
+        if (sampleSnap != nullptr)
         {
             orderedFiles.reserve (sampleSnap->sessionSamples.size() + files.size());
             sampleIds.reserve (sampleSnap->sessionSamples.size() + files.size());
@@ -838,6 +1157,7 @@ void IntersectProcessor::loadFilesAsync (const std::vector<juce::File>& files, b
                 sampleIds.push_back (sample.sampleId);
             }
         }
+        const size_t numExisting = sampleIds.size();
         for (const auto& file : files)
         {
             orderedFiles.push_back (file);
@@ -845,6 +1165,21 @@ void IntersectProcessor::loadFilesAsync (const std::vector<juce::File>& files, b
         }
         setPendingStateFile (orderedFiles.front());
         setPendingStateFiles (orderedFiles);
+
+        // Existing regions are already decoded at the current rate: decode only the
+        // new files and splice them onto the snapshot instead of re-reading everything.
+        const double sr = currentSampleRate > 0.0 ? currentSampleRate : 44100.0;
+        // Streamed sessions live in one spill file, and a progressive load still has
+        // silent regions to fill, so both re-decode everything.
+        if (sampleSnap != nullptr && numExisting > 0 && ! sampleSnap->partial
+            && sampleSnap->stream == nullptr && ! streamingMode.load (std::memory_order_relaxed)
+            && std::abs (sampleSnap->decodedSampleRate - sr) <= 0.01)
+        {
+            const std::vector<int> newSampleIds (sampleIds.begin() + (std::ptrdiff_t) numExisting, sampleIds.end());
+            requestSampleLoad (files, LoadKindPreserveSlices, &newSampleIds, std::move (sampleSnap));
+            return;
+        }
+
         requestSampleLoad (orderedFiles, LoadKindPreserveSlices, &sampleIds);
         return;
     }
@@ -906,6 +1241,76 @@ void IntersectProcessor::deleteSessionSampleAsync (int sampleId)
     if (sampleId < 0)
         return;
 
+    auto sampleSnap = sampleData.getSnapshot();
+    if (sampleSnap != nullptr && sampleSnap->sessionSamples.size() > 1)
+    {
+        // Deletes still waiting on their rebuild are not in the snapshot yet;
+        // carry them into this one so a quick second delete does not undo the first.
+        if (sessionDeleteLoadToken != latestLoadToken.load (std::memory_order_acquire))
+            sessionDeletesInFlight.clear();
+
+        int removeIndex = -1;
+        std::vector<SampleData::SessionSample> remainingSamples;
+        remainingSamples.reserve (sampleSnap->sessionSamples.size());
+        for (int i = 0; i < (int) sampleSnap->sessionSamples.size(); ++i)
+        {
+            const auto& sample = sampleSnap->sessionSamples[(size_t) i];
+            if (sample.sampleId == sampleId)
+                removeIndex = (int) remainingSamples.size();
+            else if (std::find (sessionDeletesInFlight.begin(), sessionDeletesInFlight.end(),
+                                sample.sampleId) == sessionDeletesInFlight.end())
+                remainingSamples.push_back (sample);
+        }
+
+        if (removeIndex < 0)
+            return;
+
+        if (! remainingSamples.empty())
+        {
+            // The rebuild bypasses CmdDeleteSessionSample, so take its undo step here.
+            if (! enqueueUiUndoSnapshot())
+                return;
+
+            const int nextSelectedSampleId = removeIndex < (int) remainingSamples.size()
+                ? remainingSamples[(size_t) removeIndex].sampleId
+                : remainingSamples.back().sampleId;
+
+            sessionDeletesInFlight.push_back (sampleId);
+            pendingSessionDeleteSelection.store (nextSelectedSampleId, std::memory_order_relaxed);
+
+            // A streamed session is not held in RAM to copy from, and a progressive
+            // load has not decoded all of it yet; decode the rest again.
+            if (sampleSnap->stream != nullptr || sampleSnap->partial)
+            {
+                std::vector<juce::File> files;
+                std::vector<int> sampleIds;
+                for (const auto& sample : remainingSamples)
+                {
+                    files.emplace_back (sample.filePath);
+                    sampleIds.push_back (sample.sampleId);
+                }
+
+                sessionDeleteLoadToken = requestSampleLoad (files, LoadKindPreserveSlices, &sampleIds);
+                pendingSessionDeleteToken.store (sessionDeleteLoadToken, std::memory_order_release);
+                return;
+            }
+
+            sessionDeleteLoadToken = beginLoadRequest (LoadKindPreserveSlices);
+            pendingSessionDeleteToken.store (sessionDeleteLoadToken, std::memory_order_release);
+
+            auto onSuccess = [this] (int finishedToken, LoadKind finishedKind,
+                                     std::unique_ptr<SampleData::DecodedSample> decoded)
+            {
+                publishCompletedLoad (finishedToken, finishedKind, std::move (decoded));
+            };
+
+            fileLoadPool.addJob (new SessionRebuildJob (std::move (sampleSnap), std::move (remainingSamples),
+                                                        sessionDeleteLoadToken, onSuccess), true);
+            return;
+        }
+    }
+
+    // Deleting the last sample only clears state, so the audio thread does it directly.
     Command cmd;
     cmd.type = CmdDeleteSessionSample;
     cmd.intParam1 = sampleId;
@@ -1043,14 +1448,7 @@ void IntersectProcessor::startStemSeparation (int sampleId,
     // Extract the audio region for this sample
     const int startFrame = targetSample->startFrame;
     const int numFrames = targetSample->numFrames;
-    const int numChannels = sampleSnap->buffer.getNumChannels();
-
-    juce::AudioBuffer<float> regionAudio (2, numFrames);
-    for (int ch = 0; ch < 2; ++ch)
-    {
-        const int srcCh = std::min (ch, numChannels - 1);
-        regionAudio.copyFrom (ch, 0, sampleSnap->buffer, srcCh, startFrame, numFrames);
-    }
+    auto regionAudio = sampleSnap->copyFrames (startFrame, numFrames);
 
     juce::File outputRoot = outputFolder;
     if (outputRoot == juce::File())
@@ -1129,7 +1527,7 @@ bool IntersectProcessor::applyPendingSliceTimelineRemap()
 
     const int targetFrames = sampleSnap->decodedNumFrames > 0
         ? sampleSnap->decodedNumFrames
-        : sampleSnap->buffer.getNumSamples();
+        : sampleSnap->getNumFrames();
     const double targetRate = sampleSnap->decodedSampleRate;
     if (targetFrames <= 0)
         return false;
@@ -1371,47 +1769,24 @@ void IntersectProcessor::clampSlicesToSampleBounds()
 void IntersectProcessor::deleteSessionSample (int sampleId)
 {
     const auto sampleSnap = sampleData.getSnapshot();
-    if (sampleSnap == nullptr || sampleSnap->sessionSamples.empty())
-        return;
-
-    int removeIndex = -1;
-    for (int i = 0; i < (int) sampleSnap->sessionSamples.size(); ++i)
-    {
-        if (sampleSnap->sessionSamples[(size_t) i].sampleId == sampleId)
-        {
-            removeIndex = i;
-            break;
-        }
-    }
-    if (removeIndex < 0)
-        return;
-
-    if (sampleSnap->sessionSamples.size() == 1)
-    {
-        clearVoicesBeforeSampleSwap();
-        sampleData.clear();
-        sliceManager.clearAll();
-        sampleMissing.store (false, std::memory_order_relaxed);
-        sampleAvailability.store ((int) SampleStateEmpty, std::memory_order_relaxed);
-        clearMissingFileInfo();
-        clearPendingStateFiles();
-        selectedSessionSampleId.store (-1, std::memory_order_relaxed);
-        uiSnapshotDirty.store (true, std::memory_order_release);
+    if (sampleSnap == nullptr || sampleSnap->sessionSamples.size() != 1
+        || sampleSnap->sessionSamples.front().sampleId != sampleId)
         return;
-    }
 
-    std::vector<SampleData::SessionSample> remainingSamples;
-    remainingSamples.reserve (sampleSnap->sessionSamples.size() - 1);
-    for (int i = 0; i < (int) sampleSnap->sessionSamples.size(); ++i)
-    {
-        if (i != removeIndex)
-            remainingSamples.push_back (sampleSnap->sessionSamples[(size_t) i]);
-    }
-
-    const int nextSelectedSampleId = removeIndex < (int) remainingSamples.size()
-        ? remainingSamples[(size_t) removeIndex].sampleId
-        : remainingSamples.back().sampleId;
+    clearVoicesBeforeSampleSwap();
+    sampleData.clear();
+    sliceManager.clearAll();
+    sampleMissing.store (false, std::memory_order_relaxed);
+    sampleAvailability.store ((int) SampleStateEmpty, std::memory_order_relaxed);
+    clearMissingFileInfo();
+    clearPendingStateFiles();
+    selectedSessionSampleId.store (-1, std::memory_order_relaxed);
+    uiSnapshotDirty.store (true, std::memory_order_release);
+}
 
+void IntersectProcessor::removeSlicesOfMissingSessionSamples()
+{
+    const auto& sessionSamples = sampleData.getSessionSamples();
     const int oldSelectedSlice = sliceManager.selectedSlice.load (std::memory_order_relaxed);
     const int oldNumSlices = sliceManager.getNumSlices();
     int writeSlice = 0;
@@ -1419,7 +1794,12 @@ void IntersectProcessor::deleteSessionSample (int sampleId)
     for (int i = 0; i < oldNumSlices; ++i)
     {
         const auto& src = sliceManager.getSlice (i);
-        if (src.sampleId == sampleId)
+        const bool ownerPresent = std::any_of (sessionSamples.begin(), sessionSamples.end(),
+                                               [&src] (const auto& sample)
+                                               {
+                                                   return sample.sampleId == src.sampleId;
+                                               });
+        if (! ownerPresent)
             continue;
 
         sliceManager.getSlice (writeSlice) = src;
@@ -1432,18 +1812,6 @@ void IntersectProcessor::deleteSessionSample (int sampleId)
         sliceManager.getSlice (i).active = false;
     sliceManager.setNumSlices (writeSlice);
     sliceManager.selectedSlice.store (nextSelectedSlice, std::memory_order_relaxed);
-
-    auto rebuilt = SampleData::rebuildWithSessionSamples (*sampleSnap, remainingSamples);
-    clearVoicesBeforeSampleSwap();
-    sampleData.applyDecodedSample (std::move (rebuilt));
-    sampleMissing.store (false, std::memory_order_relaxed);
-    sampleAvailability.store ((int) SampleStateLoaded, std::memory_order_relaxed);
-    clearMissingFileInfo();
-    selectedSessionSampleId.store (nextSelectedSampleId, std::memory_order_relaxed);
-    syncAllSliceAbsolutePositions();
-    clampSlicesToSampleBounds();
-    sliceManager.rebuildMidiMap();
-    uiSnapshotDirty.store (true, std::memory_order_release);
 }
 
 void IntersectProcessor::publishUiSliceSnapshot()
@@ -1461,7 +1829,7 @@ void IntersectProcessor::publishUiSliceSnapshot()
     snap.rootNote = sliceManager.rootNote.load (std::memory_order_relaxed);
     snap.sampleLoaded = (sampleSnap != nullptr);
     snap.sampleMissing = sampleMissing.load (std::memory_order_relaxed);
-    snap.sampleNumFrames = sampleSnap ? sampleSnap->buffer.getNumSamples() : 0;
+    snap.sampleNumFrames = sampleSnap ? sampleSnap->getNumFrames() : 0;
     snap.sampleSampleRate = sampleSnap ? sampleSnap->decodedSampleRate : 0.0;
     snap.hasStatusMessage = ! status.text.isEmpty();
     snap.statusIsWarning = status.isWarning;
@@ -1471,6 +1839,9 @@ void IntersectProcessor::publishUiSliceSnapshot()
     snap.stemJobSourceSampleId = stemJob.getSourceSampleId();
     snap.stemDownloadState = stemModelDownloadJob.getState();
     snap.stemDownloadProgress = stemModelDownloadJob.getProgress();
+    snap.sampleLoadFilesTotal = loadFilesTotal.load (std::memory_order_acquire);
+    snap.sampleLoadFilesDone = juce::jmin (loadFilesDone.load (std::memory_order_relaxed),
+                                           snap.sampleLoadFilesTotal);
     if (sampleSnap != nullptr)
     {
         if (snap.numSessionSamples > 1)
@@ -1820,6 +2191,11 @@ bool IntersectProcessor::applyDeferredParamRestore()
 
 void IntersectProcessor::handleCommand (const Command& cmd)
 {
+    // Session chop boundaries found in an older session are dropped before
+    // they can take an undo snapshot.
+    if (cmd.type == CmdAutoChopSession && (uint32_t) cmd.intParam1 != sampleData.getActiveGeneration())
+        return;
+
     switch (cmd.type)
     {
         case CmdNone:
@@ -1861,6 +2237,7 @@ void IntersectProcessor::handleCommand (const Command& cmd)
         case CmdDuplicateSlice:
         case CmdSplitSlice:
         case CmdTransientChop:
+        case CmdAutoChopSession:
         case CmdRepackMidi:
             if (getUiStatusMessage().source == UiStatusMessage::Source::midiLimit)
                 clearUiStatusMessage();
@@ -1914,7 +2291,7 @@ void IntersectProcessor::handleCommand (const Command& cmd)
                 const auto globals = loadGlobalParamSnapshot();
                 const auto psp = makePreviewStretchParams (globals, dawBpm.load(), currentSampleRate, &sampleData);
                 lazyChop.start (sampleData.getNumFrames(), sliceManager, psp,
-                                snapToZeroCrossing.load(), &sampleData.getBuffer());
+                                snapToZeroCrossing.load(), &sampleData);
             }
             break;
 
@@ -2248,9 +2625,9 @@ void IntersectProcessor::handleCommand (const Command& cmd)
                     if (doSnap)
                     {
                         if (i > 0)
-                            s = AudioAnalysis::findNearestZeroCrossing (sampleData.getBuffer(), s);
+                            s = sampleData.findNearestZeroCrossing (s);
                         if (i < count - 1)
-                            e = AudioAnalysis::findNearestZeroCrossing (sampleData.getBuffer(), e);
+                            e = sampleData.findNearestZeroCrossing (e);
                     }
                     if (e - s < kMinSliceLengthSamples) e = s + kMinSliceLengthSamples;
                     int idx = sliceManager.createSlice (s, e);
@@ -2355,6 +2732,44 @@ void IntersectProcessor::handleCommand (const Command& cmd)
             break;
         }
 
+        case CmdAutoChopSession:
+        {
+            const int numFrames = sampleData.getNumFrames();
+            int bounds[SliceManager::kMaxSlices + 2];
+            int numBounds = 0;
+            bounds[numBounds++] = 0;
+            for (int bi = 0; bi < cmd.numPositions; ++bi)
+                bounds[numBounds++] = cmd.positions[(size_t) bi];
+            bounds[numBounds++] = numFrames;
+
+            sliceManager.clearAll();
+            const int baseNote = sliceManager.nextMidiNote();
+
+            int numCreated = 0;
+            for (int i = 0; i + 1 < numBounds; ++i)
+            {
+                if (bounds[i + 1] - bounds[i] < kMinSliceLengthSamples)
+                    continue;
+                const int idx = sliceManager.createSlice (bounds[i], bounds[i + 1]);
+                if (idx < 0)
+                    break;
+                syncSliceOwnershipFromAbsolute (sliceManager.getSlice (idx));
+                ++numCreated;
+            }
+
+            sliceManager.rebuildMidiMap();
+            if (numCreated > 0)
+            {
+                sliceManager.selectedSlice = 0;
+                selectedSessionSampleId.store (sliceManager.getSlice (0).sampleId, std::memory_order_relaxed);
+            }
+            if (baseNote + numCreated - 1 > kMaxMidiNote)
+                setUiStatusMessage ("MIDI note limit - slices " + juce::String (kMaxMidiNote - baseNote + 2)
+                    + "+ have no unique MIDI note",
+                    true, UiStatusMessage::Source::midiLimit);
+            break;
+        }
+
         case CmdRepackMidi:
         {
             int overflowAt = sliceManager.repackMidiNotes (cmd.intParam1 != 0);
@@ -2596,7 +3011,7 @@ void IntersectProcessor::applyMidiSliceBoundarySteps (int sliceIdx, bool isStart
     }
 
     if (snapToZeroCrossing.load() && sampleData.isLoaded())
-        boundaryPos = AudioAnalysis::findNearestZeroCrossing (sampleData.getBuffer(), boundaryPos);
+        boundaryPos = sampleData.findNearestZeroCrossing (boundaryPos);
 
     if (isStart)
         liveDragBoundsStart.store (boundaryPos, std::memory_order_relaxed);
@@ -2682,108 +3097,113 @@ void IntersectProcessor::clearMidiEditGestureState()
     midiEditState.activeBoundaryIsStart = true;
 }
 
-void IntersectProcessor::processMidi (juce::MidiBuffer& midi)
+void IntersectProcessor::handleMidiMessage (const juce::MidiMessage& msg)
 {
-    const bool editEnabled = midiEditState.enabled.load (std::memory_order_acquire);
-    const int  editChannel = midiEditState.channel.load (std::memory_order_relaxed);
-    const bool doConsume   = midiEditState.consumeMidiEditCc.load (std::memory_order_relaxed);
-
-    for (const auto metadata : midi)
+    if (msg.isNoteOn())
     {
-        const auto msg = metadata.getMessage();
-
-        if (editEnabled && msg.isController()
-            && (editChannel == 0 || msg.getChannel() == editChannel))
-        {
-            if (auto midiEditEvent = tryParseMidiEditMessage (msg))
-                handleMidiEditEvent (*midiEditEvent);
-        }
+        int note = msg.getNoteNumber();
+        float velocity = (float) msg.getVelocity();
 
-        if (msg.isNoteOn())
+        if (lazyChop.isActive())
         {
-            int note = msg.getNoteNumber();
-            float velocity = (float) msg.getVelocity();
-
-            if (lazyChop.isActive())
+            // Any MIDI note places a chop boundary at the playhead
+            int newSliceIdx = lazyChop.onNote (note, voicePool, sliceManager);
+            if (newSliceIdx >= 0)
             {
-                // Any MIDI note places a chop boundary at the playhead
-                int newSliceIdx = lazyChop.onNote (note, voicePool, sliceManager);
-                if (newSliceIdx >= 0)
-                {
-                    sliceManager.selectedSlice.store (newSliceIdx, std::memory_order_relaxed);
-                    uiSnapshotDirty.store (true, std::memory_order_release);
-                }
+                sliceManager.selectedSlice.store (newSliceIdx, std::memory_order_relaxed);
+                uiSnapshotDirty.store (true, std::memory_order_release);
             }
+        }
         else
         {
-                const auto noteIndex = static_cast<size_t> (note);
-                heldNotes[noteIndex] = true;
+            const auto noteIndex = static_cast<size_t> (note);
+            heldNotes[noteIndex] = true;
 
-                // Build params once; all param loads happen here, not inside the slice loop.
-                const auto globals = loadGlobalParamSnapshot();
-                auto p = makeVoiceStartParams (globals, note, velocity, dawBpm.load());
+            // Build params once; all param loads happen here, not inside the slice loop.
+            const auto globals = loadGlobalParamSnapshot();
+            auto p = makeVoiceStartParams (globals, note, velocity, dawBpm.load());
 
-                const auto& sliceIndices = sliceManager.midiNoteToSlices (note);
-                for (int sliceIdx : sliceIndices)
-                {
-                    if (! juce::isPositiveAndBelow (sliceIdx, sliceManager.getNumSlices()))
-                        continue;
+            const auto& sliceIndices = sliceManager.midiNoteToSlices (note);
+            for (int sliceIdx : sliceIndices)
+            {
+                if (! juce::isPositiveAndBelow (sliceIdx, sliceManager.getNumSlices()))
+                    continue;
 
-                    if (midiSelectsSlice.load (std::memory_order_relaxed))
-                    {
-                        const int previous = sliceManager.selectedSlice.load (std::memory_order_relaxed);
-                        sliceManager.selectedSlice.store (sliceIdx, std::memory_order_relaxed);
-                        selectedSessionSampleId.store (sliceManager.getSlice (sliceIdx).sampleId, std::memory_order_relaxed);
-                        if (previous != sliceIdx)
-                            uiSnapshotDirty.store (true, std::memory_order_release);
-                    }
+                if (midiSelectsSlice.load (std::memory_order_relaxed))
+                {
+                    const int previous = sliceManager.selectedSlice.load (std::memory_order_relaxed);
+                    sliceManager.selectedSlice.store (sliceIdx, std::memory_order_relaxed);
+                    selectedSessionSampleId.store (sliceManager.getSlice (sliceIdx).sampleId, std::memory_order_relaxed);
+                    if (previous != sliceIdx)
+                        uiSnapshotDirty.store (true, std::memory_order_release);
+                }
 
-                    int voiceIdx = voicePool.allocate();
+                int voiceIdx = voicePool.allocate();
 
-                    // Handle mute groups
-                    const auto& s = sliceManager.getSlice (sliceIdx);
-                    int mg = (int) sliceManager.resolveParam (sliceIdx, kLockMuteGroup,
-                                                              (float) s.muteGroup, (float) p.globalMuteGroup);
-                    voicePool.muteGroup (mg, voiceIdx);
+                // Handle mute groups
+                const auto& s = sliceManager.getSlice (sliceIdx);
+                int mg = (int) sliceManager.resolveParam (sliceIdx, kLockMuteGroup,
+                                                          (float) s.muteGroup, (float) p.globalMuteGroup);
+                voicePool.muteGroup (mg, voiceIdx);
 
-                    p.sliceIdx = sliceIdx;
-                    p.sliceRootNote = s.sliceRootNote;
-                    voicePool.startVoice (voiceIdx, p, sliceManager, sampleData);
-                }
+                p.sliceIdx = sliceIdx;
+                p.sliceRootNote = s.sliceRootNote;
+                voicePool.startVoice (voiceIdx, p, sliceManager, sampleData);
             }
         }
-        else if (msg.isNoteOff())
-        {
-            int note = msg.getNoteNumber();
-            const auto noteIndex = static_cast<size_t> (note);
-            if (heldNotes[noteIndex])
-            {
-                heldNotes[noteIndex] = false;
-                voicePool.releaseNote (note);           // normal: respects oneShot
-            }
-            else
-            {
-                voicePool.releaseNoteForced (note);     // host sweep: kills even oneShot voices
-            }
-        }
-        else if (msg.isAllNotesOff())
+    }
+    else if (msg.isNoteOff())
+    {
+        int note = msg.getNoteNumber();
+        const auto noteIndex = static_cast<size_t> (note);
+        if (heldNotes[noteIndex])
         {
-            voicePool.releaseAll();  // 50ms fade on all active voices
-            lazyChop.stop (voicePool, sliceManager);
-            std::fill (std::begin (heldNotes), std::end (heldNotes), false);
+            heldNotes[noteIndex] = false;
+            voicePool.releaseNote (note);           // normal: respects oneShot
         }
-        else if (msg.isAllSoundOff())
+        else
         {
-            voicePool.killAll();     // 5ms hard kill on all active voices
-            lazyChop.stop (voicePool, sliceManager);
-            std::fill (std::begin (heldNotes), std::end (heldNotes), false);
+            voicePool.releaseNoteForced (note);     // host sweep: kills even oneShot voices
         }
     }
+    else if (msg.isAllNotesOff())
+    {
+        voicePool.releaseAll();  // 50ms fade on all active voices
+        lazyChop.stop (voicePool, sliceManager);
+        std::fill (std::begin (heldNotes), std::end (heldNotes), false);
+    }
+    else if (msg.isAllSoundOff())
+    {
+        voicePool.killAll();     // 5ms hard kill on all active voices
+        lazyChop.stop (voicePool, sliceManager);
+        std::fill (std::begin (heldNotes), std::end (heldNotes), false);
+    }
+}
+
+void IntersectProcessor::processMidiEditCcs (juce::MidiBuffer& midi)
+{
+    const bool editEnabled = midiEditState.enabled.load (std::memory_order_acquire);
+    const int  editChannel = midiEditState.channel.load (std::memory_order_relaxed);
+    const bool doConsume   = midiEditState.consumeMidiEditCc.load (std::memory_order_relaxed);
+
+    if (! editEnabled)
+        return;
+
+    for (const auto metadata : midi)
+    {
+        const auto msg = metadata.getMessage();
+        if (msg.isController() && (editChannel == 0 || msg.getChannel() == editChannel))
+            if (auto midiEditEvent = tryParseMidiEditMessage (msg))
+                handleMidiEditEvent (*midiEditEvent);
+    }
 
     // Strip MIDI edit CCs from the buffer so they don't pass downstream
-    if (editEnabled && doConsume)
+    if (doConsume)
     {
-        juce::MidiBuffer filtered;
+        // Filter through the preallocated scratch buffer, then copy back: the kept
+        // events fit in midi's own storage, and the scratch keeps its reservation.
+        filteredMidiScratch.clear();
+        bool strippedAny = false;
         for (const auto metadata : midi)
         {
             const auto msg = metadata.getMessage();
@@ -2791,10 +3211,17 @@ void IntersectProcessor::processMidi (juce::MidiBuffer& midi)
             const bool strip = msg.isController()
                 && (editChannel == 0 || msg.getChannel() == editChannel)
                 && (cc == kNrpnCcMsb || cc == kNrpnCcLsb || cc == kNrpnCcIncr || cc == kNrpnCcDecr);
-            if (! strip)
-                filtered.addEvent (msg, metadata.samplePosition);
+            if (strip)
+                strippedAny = true;
+            else
+                filteredMidiScratch.addEvent (msg, metadata.samplePosition);
+        }
+
+        if (strippedAny)
+        {
+            midi.clear();
+            midi.addEvents (filteredMidiScratch, 0, -1, 0);
         }
-        midi = std::move (filtered);
     }
 }
 
@@ -2809,10 +3236,103 @@ static inline float sanitiseSample (float x)
     return juce::jlimit (-1.0f, 1.0f, x);
 }
 
+void IntersectProcessor::renderVoicesWithMidi (juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midi)
+{
+    const int numSamples = buffer.getNumSamples();
+    const bool canRender = sampleData.isLoaded();
+
+    // Collect write pointers for all enabled output buses
+    std::array<float*, kMaxOutputBuses> busL {};
+    std::array<float*, kMaxOutputBuses> busR {};
+    int numActiveBuses = 0;
+
+    if (canRender)
+    {
+        for (int b = 0; b < std::min (getBusCount (false), kMaxOutputBuses); ++b)
+        {
+            auto* bus = getBus (false, b);
+            if (bus != nullptr && bus->isEnabled())
+            {
+                const auto busIndex = static_cast<size_t> (b);
+                int chOff = getChannelIndexInProcessBlockBuffer (false, b, 0);
+                if (chOff < buffer.getNumChannels())
+                {
+                    busL[busIndex] = buffer.getWritePointer (chOff);
+                    busR[busIndex] = (chOff + 1 < buffer.getNumChannels())
+                                  ? buffer.getWritePointer (chOff + 1) : nullptr;
+                    if (b + 1 > numActiveBuses) numActiveBuses = b + 1;
+                }
+            }
+        }
+
+        buffer.clear();
+    }
+
+    int renderedUpTo = 0;
+
+    // Renders [renderedUpTo, endSample) into the bus pointers offset to that position
+    const auto renderUpTo = [&] (int endSample)
+    {
+        if (! canRender || endSample <= renderedUpTo)
+            return;
+
+        const int offset = renderedUpTo;
+        const int length = endSample - renderedUpTo;
+        renderedUpTo = endSample;
+
+        if (numActiveBuses <= 1)
+        {
+            // Fast path: single stereo output — voice-first block render
+            voicePool.renderMainBusBlock (sampleData,
+                                          busL[0] != nullptr ? busL[0] + offset : nullptr,
+                                          busR[0] != nullptr ? busR[0] + offset : nullptr,
+                                          length);
+            return;
+        }
+
+        // Multi-out: voice-first block render with per-voice bus routing
+        std::array<float*, kMaxOutputBuses> subL {};
+        std::array<float*, kMaxOutputBuses> subR {};
+        for (int b = 0; b < numActiveBuses; ++b)
+        {
+            const auto busIndex = static_cast<size_t> (b);
+            subL[busIndex] = busL[busIndex] != nullptr ? busL[busIndex] + offset : nullptr;
+            subR[busIndex] = busR[busIndex] != nullptr ? busR[busIndex] + offset : nullptr;
+        }
+        voicePool.renderRoutedBlock (sampleData, subL.data(), subR.data(), numActiveBuses, length);
+    };
+
+    // MidiBuffer iterates in timestamp order; render up to each event, then apply it
+    for (const auto metadata : midi)
+    {
+        renderUpTo (juce::jlimit (0, numSamples, metadata.samplePosition));
+        handleMidiMessage (metadata.getMessage());
+    }
+
+    renderUpTo (numSamples);
+
+    if (! canRender)
+        return;
+
+    // Clamp / NaN-guard every active bus once after all voices have been mixed
+    for (int b = 0; b < juce::jmax (1, numActiveBuses); ++b)
+    {
+        const auto busIndex = static_cast<size_t> (b);
+        if (busL[busIndex])
+            for (int i = 0; i < numSamples; ++i)
+                busL[busIndex][i] = sanitiseSample (busL[busIndex][i]);
+        if (busR[busIndex])
+            for (int i = 0; i < numSamples; ++i)
+                busR[busIndex][i] = sanitiseSample (busR[busIndex][i]);
+    }
+}
+
 void IntersectProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                                             juce::MidiBuffer& midi)
 {
     juce::ScopedNoDenormals noDenormals;
+    const SampleStreamer::BlockScope streamBlock (streamer);
     buffer.clear();
 
     // Standalone has no host transport, so its shell provides the tempo directly.
@@ -2849,6 +3369,7 @@ void IntersectProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             const int currentToken = latestLoadToken.load (std::memory_order_acquire);
             const auto currentLoadKind = (LoadKind) latestLoadKind.load (std::memory_order_acquire);
             const bool isStateRestoreLoad = pendingStateRestoreToken.load (std::memory_order_acquire) == currentToken;
+            const bool isSessionDelete = pendingSessionDeleteToken.load (std::memory_order_acquire) == currentToken;
 
             const bool needsSampleRateRetry = decoded->filePath.isNotEmpty()
                 && currentSampleRate > 0.0
@@ -2857,19 +3378,48 @@ void IntersectProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
             if (needsSampleRateRetry)
             {
-                std::vector<juce::File> files;
-                std::vector<int> sampleIds;
-                for (const auto& sample : decoded->sessionSamples)
+                int retryToken = 0;
+                if (SampleData::canResampleFromSource (*decoded))
                 {
-                    files.emplace_back (sample.filePath);
-                    sampleIds.push_back (sample.sampleId);
+                    retryToken = requestSessionResample (SampleData::SnapshotPtr (std::move (decoded)),
+                                                         currentLoadKind);
+                }
+                else
+                {
+                    std::vector<juce::File> files;
+                    std::vector<int> sampleIds;
+                    for (const auto& sample : decoded->sessionSamples)
+                    {
+                        files.emplace_back (sample.filePath);
+                        sampleIds.push_back (sample.sampleId);
+                    }
+                    retryToken = requestSampleLoad (files, currentLoadKind, &sampleIds);
                 }
-                const int retryToken = requestSampleLoad (files, currentLoadKind, &sampleIds);
                 if (isStateRestoreLoad)
                     pendingStateRestoreToken.store (retryToken, std::memory_order_release);
+                if (isSessionDelete)
+                    pendingSessionDeleteToken.store (retryToken, std::memory_order_release);
+                reclaimer.retire (std::move (decoded));
+            }
+            else if (appliedPartialLoadToken == currentToken)
+            {
+                // More of a load that is already playing: same layout, so voices
+                // (which fetch sample pointers per block) and slices carry straight
+                // over. Lazy chop keeps a buffer pointer, so it still stops.
+                if (! decoded->partial)
+                    appliedPartialLoadToken = 0;
+                lazyChop.stop (voicePool, sliceManager);
+                sampleData.applyDecodedSample (std::move (decoded));
+                syncAllSliceAbsolutePositions();
+                clampSlicesToSampleBounds();
+                sliceManager.rebuildMidiMap();
+
+                loadStateChanged = true;
+                uiSnapshotDirty.store (true, std::memory_order_release);
             }
             else
             {
+                appliedPartialLoadToken = decoded->partial ? currentToken : 0;
                 clearVoicesBeforeSampleSwap();
                 sampleData.applyDecodedSample (std::move (decoded));
                 sampleMissing.store (false);
@@ -2890,7 +3440,10 @@ void IntersectProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                                                            {
                                                                return sample.sampleId == currentSelectedSampleId;
                                                            });
-                    if (! stillPresent)
+                    if (isSessionDelete && ! stillPresent)
+                        selectedSessionSampleId.store (pendingSessionDeleteSelection.load (std::memory_order_relaxed),
+                                                       std::memory_order_relaxed);
+                    else if (! stillPresent)
                         selectedSessionSampleId.store (sessionSamples.front().sampleId, std::memory_order_relaxed);
                 }
                 else
@@ -2915,7 +3468,7 @@ void IntersectProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                             meta.isGenerated = true;
                             setStemMeta (sessionSamples[(size_t) (firstStemIdx + i)].sampleId, meta);
                         }
-                        delete pending;
+                        reclaimer.retire (std::unique_ptr<PendingStemImport> (pending));
                     }
                 }
 
@@ -2924,6 +3477,8 @@ void IntersectProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                     sliceManager.clearAll();
                 else
                 {
+                    if (isSessionDelete)
+                        removeSlicesOfMissingSessionSamples();
                     applyPendingSliceTimelineRemap();
                     syncAllSliceAbsolutePositions();
                     clampSlicesToSampleBounds();
@@ -2932,6 +3487,8 @@ void IntersectProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
                 if (isStateRestoreLoad)
                     pendingStateRestoreToken.store (0, std::memory_order_release);
+                if (isSessionDelete)
+                    pendingSessionDeleteToken.store (0, std::memory_order_release);
 
                 loadStateChanged = true;
                 uiSnapshotDirty.store (true, std::memory_order_release);
@@ -2945,6 +3502,9 @@ void IntersectProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         {
             std::unique_ptr<FailedLoadResult> failed (rawFailure);
             const bool isStateRestoreLoad = pendingStateRestoreToken.load (std::memory_order_acquire) == failed->token;
+            // A partial session of a load that then failed keeps what it decoded.
+            if (failed->token == appliedPartialLoadToken)
+                appliedPartialLoadToken = 0;
             if (failed->token == latestLoadToken.load (std::memory_order_acquire)
                 && failed->kind == LoadKindRelink)
             {
@@ -2959,6 +3519,8 @@ void IntersectProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                 loadStateChanged = true;
                 uiSnapshotDirty.store (true, std::memory_order_release);
             }
+
+            reclaimer.retire (std::move (failed));
         }
     }
 
@@ -3011,7 +3573,24 @@ void IntersectProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     // Update max active voices from param
     voicePool.setMaxActiveVoices ((int) maxVoicesParam->load());
 
-    processMidi (midi);
+    // MIDI edits change slice bounds for the whole block, so they go before the
+    // cache refresh and the sample-accurate render
+    processMidiEditCcs (midi);
+
+    // Background-prime Signalsmith seeks and freeze renders for slices whose resolved params changed
+    if (voicePool.isStretchCacheRefreshDue (buffer.getNumSamples()))
+    {
+        const auto globals = loadGlobalParamSnapshot();
+        voicePool.refreshStretchCaches (makeVoiceStartParams (globals, 0, 0.0f, dawBpm.load()),
+                                        sliceManager, sampleData);
+    }
+
+    // Renders the voice pool in sub-blocks so each MIDI event lands on its own sample
+    renderVoicesWithMidi (buffer, midi);
+
+    const bool streaming = sampleData.isStreaming();
+    if (streaming)
+        voicePool.publishStreamHints (streamer);
 
     if (midiEditState.gestureOpen && midiEditState.previewActive)
     {
@@ -3042,70 +3621,23 @@ void IntersectProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         uiSnapshotDirty.store (true, std::memory_order_release);
 
     if (uiSnapshotDirty.exchange (false, std::memory_order_acq_rel))
-        publishUiSliceSnapshot();
-
-    if (! sampleData.isLoaded())
     {
-        if (! sampleMissing.load (std::memory_order_relaxed))
-            sampleAvailability.store ((int) SampleStateEmpty, std::memory_order_relaxed);
-        return;
-    }
-
-    // Collect write pointers for all enabled output buses
-    std::array<float*, kMaxOutputBuses> busL {};
-    std::array<float*, kMaxOutputBuses> busR {};
-    int numActiveBuses = 0;
+        publishUiSliceSnapshot();
 
-    for (int b = 0; b < std::min (getBusCount (false), kMaxOutputBuses); ++b)
-    {
-        auto* bus = getBus (false, b);
-        if (bus != nullptr && bus->isEnabled())
+        if (streaming)
         {
-            const auto busIndex = static_cast<size_t> (b);
-            int chOff = getChannelIndexInProcessBlockBuffer (false, b, 0);
-            if (chOff < buffer.getNumChannels())
-            {
-                busL[busIndex] = buffer.getWritePointer (chOff);
-                busR[busIndex] = (chOff + 1 < buffer.getNumChannels())
-                              ? buffer.getWritePointer (chOff + 1) : nullptr;
-                if (b + 1 > numActiveBuses) numActiveBuses = b + 1;
-            }
+            std::array<int, SliceManager::kMaxSlices> starts;
+            const int numSlices = juce::jmin (sliceManager.getNumSlices(), SliceManager::kMaxSlices);
+            for (int i = 0; i < numSlices; ++i)
+                starts[(size_t) i] = sliceManager.getSlice (i).startSample;
+            streamer.setHeadStarts (starts.data(), numSlices);
         }
     }
 
-    buffer.clear();
-
-    const int numSamples = buffer.getNumSamples();
-
-    if (numActiveBuses <= 1)
-    {
-        // Fast path: single stereo output — voice-first block render
-        voicePool.renderMainBusBlock (sampleData, busL[0], busR[0], numSamples);
-
-        // Sanitise once after all voices have been mixed
-        if (busL[0])
-            for (int i = 0; i < numSamples; ++i)
-                busL[0][i] = sanitiseSample (busL[0][i]);
-        if (busR[0])
-            for (int i = 0; i < numSamples; ++i)
-                busR[0][i] = sanitiseSample (busR[0][i]);
-    }
-    else
+    if (! sampleData.isLoaded())
     {
-        // Multi-out: voice-first block render with per-voice bus routing
-        voicePool.renderRoutedBlock (sampleData, busL.data(), busR.data(), numActiveBuses, numSamples);
-
-        // Clamp / NaN-guard every active bus after accumulation
-        for (int b = 0; b < numActiveBuses; ++b)
-        {
-            const auto busIndex = static_cast<size_t> (b);
-            if (busL[busIndex])
-                for (int i = 0; i < numSamples; ++i)
-                    busL[busIndex][i] = sanitiseSample (busL[busIndex][i]);
-            if (busR[busIndex])
-                for (int i = 0; i < numSamples; ++i)
-                    busR[busIndex][i] = sanitiseSample (busR[busIndex][i]);
-        }
+        if (! sampleMissing.load (std::memory_order_relaxed))
+            sampleAvailability.store ((int) SampleStateEmpty, std::memory_order_relaxed);
     }
 
     // Pass through MIDI
@@ -3245,7 +3777,7 @@ void IntersectProcessor::getStateInformation (juce::MemoryBlock& destData)
 
     // Optional v24 extension block for fields added without changing the base version.
     stream.writeInt (kStateExtensionMagic);
-    stream.writeInt (5);
+    stream.writeInt (8);
     stream.writeInt (numSlices);
     for (int i = 0; i < numSlices; ++i)
         stream.writeInt (sliceManager.getSlice (i).repitchMode);
@@ -3295,6 +3827,12 @@ void IntersectProcessor::getStateInformation (juce::MemoryBlock& destData)
         stream.writeInt (static_cast<int> (meta.role));
         stream.writeBool (meta.isGenerated);
     }
+    // Extension v6: in-memory sample storage format
+    stream.writeInt (sampleStorage.load (std::memory_order_relaxed));
+    // Extension v7: disk streaming
+    stream.writeBool (streamingMode.load (std::memory_order_relaxed));
+    // Extension v8: on-disk decode cache
+    stream.writeBool (isDiskDecodeCacheEnabled());
 }
 
 void IntersectProcessor::setStateInformation (const void* data, int sizeInBytes)
@@ -3420,6 +3958,9 @@ void IntersectProcessor::setStateInformation (const void* data, int sizeInBytes)
         bool midiEditEnabled = false;
         int midiEditChannel = 0;
         bool consumeMidiEditCc = true;
+        int sampleStorage = (int) SampleData::Storage::Float32;
+        bool streamingMode = false;
+        bool diskDecodeCache = false;
         std::vector<int> repitchModes;
         std::vector<int> loopStartOffsets;
         std::vector<int> loopLengths;
@@ -3631,6 +4172,32 @@ void IntersectProcessor::setStateInformation (const void* data, int sizeInBytes)
                         }
                     }
                 }
+
+                if (extensionVersion >= 6)
+                {
+                    if (! requireBytes (4))
+                        return result;
+
+                    result.sampleStorage = juce::jlimit ((int) SampleData::Storage::Float32,
+                                                         (int) SampleData::Storage::Interleaved,
+                                                         trialStream.readInt());
+                }
+
+                if (extensionVersion >= 7)
+                {
+                    if (! requireBytes (1))
+                        return result;
+
+                    result.streamingMode = trialStream.readBool();
+                }
+
+                if (extensionVersion >= 8)
+                {
+                    if (! requireBytes (1))
+                        return result;
+
+                    result.diskDecodeCache = trialStream.readBool();
+                }
             }
             else
             {
@@ -3720,6 +4287,11 @@ void IntersectProcessor::setStateInformation (const void* data, int sizeInBytes)
     int savedSourceNumFrames = postSliceResult->savedSourceNumFrames;
     double savedSourceSampleRate = postSliceResult->savedSourceSampleRate;
 
+    // The restore load below decodes into the saved storage format and mode.
+    sampleStorage.store (postSliceResult->sampleStorage, std::memory_order_relaxed);
+    streamingMode.store (postSliceResult->streamingMode, std::memory_order_relaxed);
+    setDiskDecodeCacheEnabled (postSliceResult->diskDecodeCache);
+
     clearVoicesBeforeSampleSwap();
     sampleData.clear();
 
@@ -5,7 +5,10 @@
 #include <vector>
 #include "Constants.h"
 #include "RtText.h"
+#include "audio/DiskDecodeCache.h"
 #include "audio/SampleData.h"
+#include "audio/SampleStreamer.h"
+#include "audio/SessionOdfCache.h"
 #include "audio/SliceManager.h"
 #include "audio/VoicePool.h"
 #include "audio/LazyChopEngine.h"
@@ -67,6 +70,7 @@ public:
         CmdDuplicateSlice,
         CmdSplitSlice,
         CmdTransientChop,
+        CmdAutoChopSession,
         CmdRepackMidi,
         CmdRelinkFile,
         CmdFileLoadCompleted,
@@ -201,6 +205,38 @@ public:
     void relinkFileAsync (const juce::File& file);
     void reorderSessionSampleAsync (int sourceSampleId, int targetIndex);
     void deleteSessionSampleAsync (int sampleId);
+
+    // Memory cap for decoded files kept resident so reorder/undo skip the disk.
+    // The cache is shared by every instance in the process; 0 disables it.
+    void setDecodedRegionCacheCapacity (size_t bytes) { regionCache->setCapacityBytes (bytes); }
+    size_t getDecodedRegionCacheCapacity() const { return regionCache->getCapacityBytes(); }
+    // Keep source-rate audio of resampled files so host rate changes resample
+    // from memory. Costs a second copy of each such file, so off by default.
+    // Applies to loads started afterwards.
+    void setRetainSourcePcm (bool shouldRetain) { retainSourcePcm.store (shouldRetain, std::memory_order_relaxed); }
+    bool isRetainingSourcePcm() const { return retainSourcePcm.load (std::memory_order_relaxed); }
+    // Decode later loads to a disk spill file and stream them to the audio
+    // thread instead of holding the whole session in RAM. Saved with the project.
+    void setStreamingMode (bool shouldStream) { streamingMode.store (shouldStream, std::memory_order_relaxed); }
+    bool isStreamingMode() const { return streamingMode.load (std::memory_order_relaxed); }
+    uint64_t getStreamUnderrunBlocks() const { return streamer.getNumUnderrunBlocks(); }
+    uint64_t getStreamUnderrunReads() const  { return streamer.getNumUnderrunReads(); }
+    // In-memory format of decoded sessions, saved with the project. Applies to
+    // loads started afterwards.
+    void setSampleStorage (SampleData::Storage storage) { sampleStorage.store ((int) storage, std::memory_order_relaxed); }
+    SampleData::Storage getSampleStorage() const { return (SampleData::Storage) sampleStorage.load (std::memory_order_relaxed); }
+    // Opt-in on-disk cache of decoded files so reopened projects skip decoding.
+    // An empty directory means the shared default. Saved with the project;
+    // applies to loads started afterwards.
+    void setDiskDecodeCacheEnabled (bool shouldCache, const juce::File& directory = {});
+    bool isDiskDecodeCacheEnabled() const;
+    void setDiskDecodeCacheCapacity (juce::int64 bytes);
+    // Helper threads for background analysis; shared with multi-file decoding.
+    juce::ThreadPool& getWorkerPool() { return decodePool; }
+    const SessionOdfCache& getOdfCache() const { return odfCache; }
+    // Chops every session sample at its onsets in the background. The slices
+    // land as one CmdAutoChopSession, replacing all others in one undo step.
+    void startSessionAutoChop (float sensitivity, float minSliceLenMs);
     void startStemSeparation (int sampleId,
                               StemModelId modelId,
                               StemSelectionMask stemSelectionMask,
@@ -249,6 +285,8 @@ public:
         int stemJobSourceSampleId = -1;
         StemModelDownloadState stemDownloadState = StemModelDownloadState::idle;
         float stemDownloadProgress = 0.0f;
+        int sampleLoadFilesDone = 0;
+        int sampleLoadFilesTotal = 0;   // 0 when no file load is in flight
         std::array<UiSessionSample, SampleData::kMaxSessionSamples> sessionSamples {};
         std::array<Slice, SliceManager::kMaxSlices> slices {};
     };
@@ -290,6 +328,10 @@ public:
         return true;
     }
 
+    // Frees payloads dropped on the audio thread. Declared first so it outlives
+    // everything that retires into it; its counters are public for tests.
+    DeferredReclaimer reclaimer;
+
     // Public state for UI access
     SampleData     sampleData;
     SliceManager   sliceManager;
@@ -395,7 +437,9 @@ private:
 
     void drainCommands();
     void handleCommand (const Command& cmd);
-    void processMidi (juce::MidiBuffer& midi);
+    void handleMidiMessage (const juce::MidiMessage& msg);
+    void processMidiEditCcs (juce::MidiBuffer& midi);
+    void renderVoicesWithMidi (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi);
     std::optional<MidiEditEvent> tryParseMidiEditMessage (const juce::MidiMessage& msg);
     void handleMidiEditEvent (const MidiEditEvent& event);
     void applyMidiEditZoomSteps (int steps);
@@ -406,10 +450,16 @@ private:
     void commitMidiSliceBoundaryGestureIfIdle (int blockSamples);
     void clearMidiEditGestureState();
     int requestSampleLoad (const std::vector<juce::File>& files, LoadKind kind,
-                           const std::vector<int>* sampleIds = nullptr);
+                           const std::vector<int>* sampleIds = nullptr,
+                           SampleData::SnapshotPtr appendBase = {});
+    int requestSessionResample (SampleData::SnapshotPtr source, LoadKind kind);
+    int beginLoadRequest (LoadKind kind);
+    void publishCompletedLoad (int token, LoadKind kind, std::unique_ptr<SampleData::DecodedSample> decoded);
+    void publishPartialLoad (int token, std::unique_ptr<SampleData::DecodedSample> decoded);
     void clearVoicesBeforeSampleSwap();
     void clampSlicesToSampleBounds();
     void deleteSessionSample (int sampleId);
+    void removeSlicesOfMissingSessionSamples();
     void syncAllSliceOwnershipToCurrentSession();
     void syncSliceOwnershipFromAbsolute (Slice& slice, bool clampToSessionBounds = true);
     void syncSliceAbsoluteToCurrentSession (Slice& slice);
@@ -419,6 +469,7 @@ private:
     void publishUiSliceSnapshot();
     void handleAsyncUpdate() override;
     void handleStemJobCompletionOnMessageThread();
+    void handleSessionChopCompletionOnMessageThread();
     void setMissingFileInfo (const RtText<512>& fileName, const RtText<4096>& filePath);
     void clearMissingFileInfo();
     const MissingFileInfo& getMissingFileInfo() const;
@@ -512,13 +563,34 @@ private:
     };
     std::atomic<PendingStemImport*> pendingStemImport { nullptr };
 
+    juce::SharedResourcePointer<DecodedRegionCache> regionCache;   // outlives fileLoadPool's jobs
     juce::ThreadPool fileLoadPool { 1 };
+    juce::ThreadPool decodePool { juce::jlimit (1, 8, juce::SystemStats::getNumCpus() - 1) };
+    std::atomic<int> loadFilesDone { 0 };
+    std::atomic<int> loadFilesTotal { 0 };
+    std::atomic<bool> retainSourcePcm { false };
+    std::atomic<bool> streamingMode { false };
+    std::atomic<int> sampleStorage { (int) SampleData::Storage::Float32 };
+    juce::CriticalSection diskDecodeCacheLock;
+    std::shared_ptr<DiskDecodeCache> diskDecodeCache;   // null unless enabled; guarded by the lock
+    juce::int64 diskDecodeCacheCapacity = DiskDecodeCache::kDefaultCapacityBytes;
+    SampleStreamer streamer { sampleData };   // after sampleData, which it reads
+    SessionOdfCache odfCache { sampleData, decodePool };
     std::atomic<int> nextLoadToken { 0 };
     std::atomic<int> nextSessionSampleId { 0 };
     std::atomic<int> latestLoadToken { 0 };
     std::atomic<int> latestLoadKind { (int) LoadKindReplace };
     std::atomic<SampleData::DecodedSample*> completedLoadData { nullptr };
     std::atomic<FailedLoadResult*> completedLoadFailure { nullptr };
+    int appliedPartialLoadToken = 0;   // audio thread: load whose partial session is playing
+
+    // Boundaries from the last whole-session auto chop, handed to the message thread.
+    struct SessionChopResult
+    {
+        std::vector<int> boundaries;
+        uint32_t generation = 0;   // session the boundaries were found in
+    };
+    std::atomic<SessionChopResult*> completedSessionChop { nullptr };
     std::array<UiSliceSnapshot, 2> uiSliceSnapshots {};
     std::atomic<int> uiSliceSnapshotIndex { 0 };
     std::atomic<bool> uiSnapshotDirty { true };
@@ -526,6 +598,7 @@ private:
     PendingSliceTimelineRemap pendingSliceTimelineRemap;
 
     std::array<bool, kMidiNoteCount> heldNotes {};
+    juce::MidiBuffer filteredMidiScratch;   // audio thread only; reserved in prepareToPlay
 
     std::array<ParamUndoState, 2> pendingParamRestoreStates {};
     std::atomic<int> pendingParamRestoreIndex { -1 };
@@ -534,6 +607,13 @@ private:
     std::array<UiStatusMessage, 2> uiStatusMessages {};
     std::atomic<int> uiStatusMessageIndex { 0 };
     std::atomic<int> pendingStateRestoreToken { 0 };
+
+    // Session sample deletion: the rebuild runs on fileLoadPool and lands through
+    // completedLoadData; the handoff drops the deleted samples' slices.
+    std::atomic<int> pendingSessionDeleteToken { 0 };
+    std::atomic<int> pendingSessionDeleteSelection { -1 };
+    std::vector<int> sessionDeletesInFlight;   // message thread only
+    int sessionDeleteLoadToken = 0;            // message thread only
     juce::File pendingStateFile;
     std::vector<juce::File> pendingStateFiles;
     mutable juce::CriticalSection pendingStateFileLock;
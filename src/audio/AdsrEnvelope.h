@@ -77,6 +77,91 @@ public:
         return level;
     }
 
+    // Renders up to numSamples levels into dest. Stops on the sample that finishes the
+    // release (not written) and returns how many audible samples were produced.
+    int processBlock (float* dest, int numSamples)
+    {
+        int n = 0;
+        while (n < numSamples)
+        {
+            if (state == Sustain)
+            {
+                level = sustainLvl;
+                for (; n < numSamples; ++n)
+                    dest[n] = level;
+                break;
+            }
+
+            const float value = processSample();
+            if (state == Done)
+                break;
+            dest[n++] = value;
+        }
+
+        return n;
+    }
+
+    // The current stage's step from processSample() as
+    // level = level * keep + coeff * (target - level), for the vectorised voice
+    // kernel: keep is 1 except in Release, whose step is a plain multiply.
+    // Only meaningful while isStageStableFor() holds.
+    float getStageKeep() const
+    {
+        return state == Release ? 1.0f - releaseCoeff : 1.0f;
+    }
+
+    float getStageCoeff() const
+    {
+        switch (state)
+        {
+            case Attack:  return attackCoeff;
+            case Decay:   return decayCoeff;
+            default:      return 0.0f;
+        }
+    }
+
+    float getStageTarget() const
+    {
+        switch (state)
+        {
+            case Attack: return 1.01f;
+            case Decay:  return sustainLvl;
+            default:     return state == Sustain ? sustainLvl : 0.0f;
+        }
+    }
+
+    // True if the next numSamples stay in the current stage (with a small safety margin).
+    bool isStageStableFor (int numSamples) const
+    {
+        switch (state)
+        {
+            case Sustain:
+                return true;
+
+            case Attack:
+                if (attackCoeff >= 1.0f)
+                    return false;
+                return 1.01 - (1.01 - level) * std::pow (1.0 - attackCoeff, numSamples) < 1.0 - 1.0e-4;
+
+            case Decay:
+                if (decayCoeff >= 1.0f)
+                    return false;
+                return sustainLvl + (level - sustainLvl) * std::pow (1.0 - decayCoeff, numSamples)
+                       > sustainLvl + 0.001 + 1.0e-4;
+
+            case Release:
+                return level * std::pow (1.0 - releaseCoeff, numSamples) > 0.00016;
+
+            case Done:
+                break;
+        }
+
+        return false;
+    }
+
+    // Writes back a level produced by the vectorised kernel within the same stage.
+    void setStageLevel (float newLevel) { level = newLevel; }
+
     bool  isDone()    const { return state == Done; }
     State getState()  const { return state; }
     float getLevel()  const { return level; }
@@ -0,0 +1,153 @@
+#include "AudioAnalysis.h"
+#include "SimdOps.h"
+#include <pffft.h>
+#include <atomic>
+#include <memory>
+
+namespace
+{
+constexpr int kFftSize = AudioAnalysis::kOdfFftSize;
+constexpr int kHopSize = AudioAnalysis::kOdfHopSize;
+constexpr int kNumBins = kFftSize / 2 + 1;
+constexpr int kFramesPerBatch = 64;   // each batch re-analyses one frame before it
+
+struct AlignedFree
+{
+    void operator() (float* p) const { pffft_aligned_free (p); }
+};
+
+struct SetupFree
+{
+    void operator() (PFFFT_Setup* s) const { pffft_destroy_setup (s); }
+};
+
+using AlignedFloats = std::unique_ptr<float, AlignedFree>;
+
+AlignedFloats allocateAligned (int n)
+{
+    return AlignedFloats (static_cast<float*> (pffft_aligned_malloc ((size_t) n * sizeof (float))));
+}
+
+// Work shared between the analysing thread and its pool helpers. Batches of
+// frames are claimed by index and each writes only its own stretch of odf.
+// Helpers hold a reference, so ones that start after the caller has returned
+// just find nothing to do.
+struct FluxJob
+{
+    const float* left = nullptr;
+    const float* right = nullptr;
+    int start = 0;
+    int numOdfFrames = 0;
+    int numBatches = 0;
+    float* odf = nullptr;
+
+    std::unique_ptr<PFFFT_Setup, SetupFree> setup;
+    std::vector<float> window;   // Hann, with the 0.5 of the mono mix folded in
+
+    std::atomic<int> nextBatch { 0 };
+    std::atomic<int> numFinished { 0 };
+    juce::WaitableEvent allFinished;
+
+    void work()
+    {
+        AlignedFloats input, output, scratch;
+        std::vector<float> prevMag, currMag;
+
+        for (;;)
+        {
+            const int b = nextBatch.fetch_add (1, std::memory_order_relaxed);
+            if (b >= numBatches)
+                return;
+
+            if (input == nullptr)
+            {
+                input = allocateAligned (kFftSize);
+                output = allocateAligned (kFftSize);
+                scratch = allocateAligned (kFftSize);
+                prevMag.resize (kNumBins);
+                currMag.resize (kNumBins);
+            }
+
+            const auto magnitudesAt = [&] (int frame, float* mags)
+            {
+                using Vec = SimdOps::FloatVec;
+                const float* l = left + start + frame * kHopSize;
+                const float* r = right + start + frame * kHopSize;
+                for (int i = 0; i < kFftSize; i += Vec::kLanes)
+                    ((Vec::load (l + i) + Vec::load (r + i)) * Vec::load (window.data() + i)).store (input.get() + i);
+
+                pffft_transform_ordered (setup.get(), input.get(), output.get(), scratch.get(), PFFFT_FORWARD);
+
+                // Ordered real output: DC, Nyquist, then bins 1 .. N/2 - 1 as (re, im).
+                mags[0] = std::abs (output.get()[0]);
+                mags[kNumBins - 1] = std::abs (output.get()[1]);
+                SimdOps::complexMagnitudes (output.get() + 2, mags + 1, kNumBins - 2);
+            };
+
+            const int first = b * kFramesPerBatch;
+            const int last = std::min (first + kFramesPerBatch, numOdfFrames);
+
+            if (first > 0)
+                magnitudesAt (first - 1, prevMag.data());
+            else
+                std::fill (prevMag.begin(), prevMag.end(), 0.0f);
+
+            for (int f = first; f < last; ++f)
+            {
+                magnitudesAt (f, currMag.data());
+                odf[f] = SimdOps::positiveDifferenceSum (currMag.data(), prevMag.data(), kNumBins);
+                std::swap (prevMag, currMag);
+            }
+
+            if (numFinished.fetch_add (1, std::memory_order_acq_rel) + 1 == numBatches)
+                allFinished.signal();
+        }
+    }
+};
+} // namespace
+
+namespace AudioAnalysis
+{
+
+ODFResult computeSpectralFluxODF (const juce::AudioBuffer<float>& buffer, int start, int end,
+                                  double /*sampleRate*/, juce::ThreadPool* pool)
+{
+    ODFResult result;
+    result.start = start;
+    result.end   = end;
+    result.frameStart = start;
+    result.hopSize = kHopSize;
+    result.fftSize = kFftSize;
+
+    const int numFrames = buffer.getNumSamples();
+    if (numFrames == 0 || start < 0 || end <= start || end > numFrames || end - start < kFftSize)
+        return result;
+
+    auto job = std::make_shared<FluxJob>();
+    job->left = buffer.getReadPointer (0);
+    job->right = buffer.getNumChannels() > 1 ? buffer.getReadPointer (1) : job->left;
+    job->start = start;
+    job->numOdfFrames = (end - start - kFftSize) / kHopSize + 1;
+    job->numBatches = (job->numOdfFrames + kFramesPerBatch - 1) / kFramesPerBatch;
+
+    job->setup.reset (pffft_new_setup (kFftSize, PFFFT_REAL));
+    if (job->setup == nullptr)
+        return result;
+
+    job->window.resize (kFftSize);
+    for (int i = 0; i < kFftSize; ++i)
+        job->window[(size_t) i] = 0.25f * (1.0f - std::cos (2.0f * juce::MathConstants<float>::pi * (float) i / (float) kFftSize));
+
+    result.odf.resize ((size_t) job->numOdfFrames);
+    job->odf = result.odf.data();
+
+    const int numHelpers = pool != nullptr ? std::min (pool->getNumThreads(), job->numBatches - 1) : 0;
+    for (int h = 0; h < numHelpers; ++h)
+        pool->addJob ([job] { job->work(); });
+
+    job->work();
+    job->allFinished.wait (-1);
+    return result;
+}
+
+} // namespace AudioAnalysis
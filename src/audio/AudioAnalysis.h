@@ -1,28 +1,23 @@
 #pragma once
 #include <juce_audio_basics/juce_audio_basics.h>
-#include <juce_dsp/juce_dsp.h>
 #include <vector>
 #include <cmath>
 #include <algorithm>
 #include <deque>
 #include <iterator>
 #include <numeric>
+#include <set>
 
 namespace AudioAnalysis
 {
 
-inline int findNearestZeroCrossing (const juce::AudioBuffer<float>& buffer, int pos,
-                                     int searchRange = 512)
+// Zero-crossing search over any frame source: mono (i) returns the mono mix of frame i.
+template <typename MonoReader>
+int findNearestZeroCrossingIn (int numFrames, int pos, MonoReader&& mono, int searchRange = 512)
 {
-    int numFrames = buffer.getNumSamples();
     if (numFrames == 0 || pos < 0 || pos >= numFrames)
         return pos;
 
-    const float* L = buffer.getReadPointer (0);
-    const float* R = buffer.getNumChannels() > 1 ? buffer.getReadPointer (1) : L;
-
-    auto mono = [&] (int i) -> float { return (L[i] + R[i]) * 0.5f; };
-
     int bestPos = pos;
     int bestDist = searchRange + 1;
 
@@ -47,84 +42,137 @@ inline int findNearestZeroCrossing (const juce::AudioBuffer<float>& buffer, int
     return bestPos;
 }
 
+inline int findNearestZeroCrossing (const juce::AudioBuffer<float>& buffer, int pos,
+                                     int searchRange = 512)
+{
+    if (buffer.getNumChannels() < 1)
+        return pos;
+
+    const float* L = buffer.getReadPointer (0);
+    const float* R = buffer.getNumChannels() > 1 ? buffer.getReadPointer (1) : L;
+
+    return findNearestZeroCrossingIn (buffer.getNumSamples(), pos,
+                                      [L, R] (int i) { return (L[i] + R[i]) * 0.5f; },
+                                      searchRange);
+}
+
+constexpr int kOdfFftSize = 1024;
+constexpr int kOdfHopSize = 256;
+
 // Result of the expensive STFT spectral flux computation.
 struct ODFResult
 {
     std::vector<float> odf;
-    int hopSize  = 0;
-    int fftSize  = 0;
-    int start    = 0;
-    int end      = 0;
+    int hopSize    = 0;
+    int fftSize    = 0;
+    int start      = 0;
+    int end        = 0;
+    int frameStart = 0;   // where odf[0]'s frame begins; start unless served from a cache
 };
 
-// Phase 1 (expensive): Compute spectral flux onset detection function via STFT.
-// This is the heavy part — ~5000 FFTs for a 30-second sample at 44.1kHz.
-inline ODFResult computeSpectralFluxODF (const juce::AudioBuffer<float>& buffer,
-                                          int start, int end,
-                                          double /*sampleRate*/ = 44100.0)
+// Phase 1 (expensive): Compute spectral flux onset detection function via STFT
+// (kOdfFftSize-point pffft frames, kOdfHopSize hop). Batches of frames are spread over pool's
+// threads as well as the caller's; without a pool it runs on the caller alone.
+ODFResult computeSpectralFluxODF (const juce::AudioBuffer<float>& buffer,
+                                  int start, int end,
+                                  double sampleRate = 44100.0,
+                                  juce::ThreadPool* pool = nullptr);
+
+// Median of a sliding window in O(log w) per step: the window is split into a
+// lower and an upper half, and the median is the smallest of the upper half
+// (sorted element size / 2, matching nth_element on the same window).
+class SlidingMedian
 {
-    ODFResult result;
-    result.start = start;
-    result.end   = end;
-
-    constexpr int fftOrder = 10;
-    constexpr int fftSize  = 1 << fftOrder;  // 1024
-    constexpr int hopSize  = 256;
-    constexpr int numBins  = fftSize / 2 + 1;
+public:
+    void add (float x)
+    {
+        if (upper.empty() || x >= *upper.begin())
+            upper.insert (x);
+        else
+            lower.insert (x);
+        rebalance();
+    }
 
-    result.hopSize = hopSize;
-    result.fftSize = fftSize;
+    // x must be in the window.
+    void remove (float x)
+    {
+        if (! lower.empty() && x <= *lower.rbegin())
+            lower.erase (lower.find (x));
+        else
+            upper.erase (upper.find (x));
+        rebalance();
+    }
 
-    int numFrames = buffer.getNumSamples();
-    if (numFrames == 0 || start < 0 || end <= start || end > numFrames)
-        return result;
+    float median() const { return *upper.begin(); }
 
-    const float* L = buffer.getReadPointer (0);
-    const float* R = buffer.getNumChannels() > 1 ? buffer.getReadPointer (1) : L;
+private:
+    void rebalance()
+    {
+        const size_t wantLower = (lower.size() + upper.size()) / 2;
+        while (lower.size() > wantLower)
+        {
+            upper.insert (*lower.rbegin());
+            lower.erase (std::prev (lower.end()));
+        }
+        while (lower.size() < wantLower)
+        {
+            lower.insert (*upper.begin());
+            upper.erase (upper.begin());
+        }
+    }
 
-    // Precompute Hann window
-    std::vector<float> hannWindow (fftSize);
-    for (int i = 0; i < fftSize; ++i)
-        hannWindow[(size_t) i] = 0.5f * (1.0f - std::cos (2.0f * juce::MathConstants<float>::pi * (float) i / (float) fftSize));
+    std::multiset<float> lower, upper;
+};
 
-    juce::dsp::FFT fft (fftOrder);
+// Median of odf[i - radius, i + radius], clipped to the ODF, for every i.
+inline std::vector<float> movingMedian (const std::vector<float>& odf, int radius)
+{
+    std::vector<float> medians (odf.size());
+    if (odf.empty())
+        return medians;
 
-    std::vector<float> fftData (2 * (size_t) fftSize, 0.0f);
-    std::vector<float> prevMag (numBins, 0.0f);
-    std::vector<float> currMag (numBins);
+    SlidingMedian window;
+    for (size_t j = 0; j <= std::min ((size_t) radius, odf.size() - 1); ++j)
+        window.add (odf[j]);
 
-    for (int pos = start; pos + fftSize <= end; pos += hopSize)
+    for (size_t i = 0; i < odf.size(); ++i)
     {
-        std::fill (fftData.begin(), fftData.end(), 0.0f);
-        for (int i = 0; i < fftSize; ++i)
-        {
-            int idx = pos + i;
-            float mono = (L[idx] + R[idx]) * 0.5f;
-            fftData[(size_t) i] = mono * hannWindow[(size_t) i];
-        }
+        if (i > 0 && i + (size_t) radius < odf.size())
+            window.add (odf[i + (size_t) radius]);
+        if (i > (size_t) radius)
+            window.remove (odf[i - (size_t) radius - 1]);
 
-        fft.performRealOnlyForwardTransform (fftData.data());
+        medians[i] = window.median();
+    }
 
-        for (int k = 0; k < numBins; ++k)
-        {
-            float re = fftData[(size_t) (2 * k)];
-            float im = fftData[(size_t) (2 * k + 1)];
-            currMag[(size_t) k] = std::sqrt (re * re + im * im);
-        }
+    return medians;
+}
 
-        float flux = 0.0f;
-        for (int k = 0; k < numBins; ++k)
-        {
-            float diff = currMag[(size_t) k] - prevMag[(size_t) k];
-            if (diff > 0.0f)
-                flux += diff;
-        }
+struct OnsetCandidate
+{
+    int samplePos;
+    float strength;
+};
+
+// Greedy strongest-first: a candidate is kept unless a stronger kept one lies
+// closer than minDistance. Returns the kept positions in ascending order.
+inline std::vector<int> keepStrongestApart (std::vector<OnsetCandidate> candidates, int minDistance)
+{
+    std::sort (candidates.begin(), candidates.end(),
+               [] (const OnsetCandidate& a, const OnsetCandidate& b) { return a.strength > b.strength; });
 
-        result.odf.push_back (flux);
-        std::swap (prevMag, currMag);
+    // Kept onsets stay ordered, so only the nearest one on each side is checked.
+    std::set<int> kept;
+    for (const auto& c : candidates)
+    {
+        const auto next = kept.lower_bound (c.samplePos);
+        const bool tooClose = (next != kept.end() && *next - c.samplePos < minDistance)
+                           || (next != kept.begin() && c.samplePos - *std::prev (next) < minDistance);
+        if (! tooClose)
+            kept.insert (next, c.samplePos);
     }
 
-    return result;
+    return { kept.begin(), kept.end() };
 }
 
 // Phase 2 (cheap): Pick transients from a pre-computed ODF.
@@ -135,8 +183,6 @@ inline std::vector<int> pickTransientsFromODF (const ODFResult& odfResult,
                                                 double sampleRate = 44100.0,
                                                 float minSliceLenMs = 100.0f)
 {
-    std::vector<int> onsets;
-
     const auto& odf = odfResult.odf;
     const int hopSize = odfResult.hopSize;
     const int fftSize = odfResult.fftSize;
@@ -144,7 +190,7 @@ inline std::vector<int> pickTransientsFromODF (const ODFResult& odfResult,
     const int end     = odfResult.end;
 
     if (odf.size() < 5)
-        return onsets;
+        return {};
 
     constexpr int peakRadius = 3;
     constexpr float delta = 1e-4f;
@@ -156,33 +202,12 @@ inline std::vector<int> pickTransientsFromODF (const ODFResult& odfResult,
     float lambda = std::max (0.1f, sensitivity);
     int medianW = 10;
 
-    std::vector<float> threshold (odf.size());
-    std::vector<float> window;
-    window.reserve ((size_t) (2 * medianW + 1));
-
-    for (size_t i = 0; i < odf.size(); ++i)
-    {
-        size_t lo = i > (size_t) medianW ? i - (size_t) medianW : 0;
-        size_t hi = std::min (i + (size_t) medianW, odf.size() - 1);
-
-        window.clear();
-        for (size_t j = lo; j <= hi; ++j)
-            window.push_back (odf[j]);
-
-        size_t mid = window.size() / 2;
-        std::nth_element (window.begin(), window.begin() + (ptrdiff_t) mid, window.end());
-        float median = window[mid];
-
-        threshold[i] = delta + lambda * median;
-    }
+    std::vector<float> threshold = movingMedian (odf, medianW);
+    for (auto& t : threshold)
+        t = delta + lambda * t;
 
     // --- Peak-pick — local maxima above adaptive threshold ---
-    struct Onset
-    {
-        int samplePos;
-        float strength;
-    };
-    std::vector<Onset> candidates;
+    std::vector<OnsetCandidate> candidates;
 
     for (size_t i = 1; i < odf.size() - 1; ++i)
     {
@@ -201,7 +226,7 @@ inline std::vector<int> pickTransientsFromODF (const ODFResult& odfResult,
         if (! isLocalMax)
             continue;
 
-        int samplePos = start + (int) i * hopSize + fftSize / 2;
+        int samplePos = odfResult.frameStart + (int) i * hopSize + fftSize / 2;
         samplePos = std::min (samplePos, end);
         if (samplePos > start)
             candidates.push_back ({ samplePos, odf[i] });
@@ -266,7 +291,7 @@ inline std::vector<int> pickTransientsFromODF (const ODFResult& odfResult,
         };
 
         std::sort (candidates.begin(), candidates.end(),
-                   [] (const Onset& a, const Onset& b) { return a.samplePos < b.samplePos; });
+                   [] (const OnsetCandidate& a, const OnsetCandidate& b) { return a.samplePos < b.samplePos; });
 
         for (size_t ci = 0; ci < candidates.size(); ++ci)
         {
@@ -329,29 +354,7 @@ inline std::vector<int> pickTransientsFromODF (const ODFResult& odfResult,
     int minOnsetDist = (int) std::round (sampleRate * (double) minSliceLenMs / 1000.0);
     minOnsetDist = std::max (1, minOnsetDist);
 
-    std::sort (candidates.begin(), candidates.end(),
-               [] (const Onset& a, const Onset& b) { return a.strength > b.strength; });
-
-    std::vector<int> kept;
-    for (const auto& c : candidates)
-    {
-        bool tooClose = false;
-        for (int k : kept)
-        {
-            if (std::abs (c.samplePos - k) < minOnsetDist)
-            {
-                tooClose = true;
-                break;
-            }
-        }
-        if (! tooClose)
-            kept.push_back (c.samplePos);
-    }
-
-    std::sort (kept.begin(), kept.end());
-    onsets = std::move (kept);
-
-    return onsets;
+    return keepStrongestApart (std::move (candidates), minOnsetDist);
 }
 
 // Convenience wrapper — calls both phases sequentially. Preserves the original API
@@ -0,0 +1,88 @@
+#include "CompactPcm.h"
+#include <algorithm>
+#include <cmath>
+
+static uint16_t encodeSample (float x, CompactPcm::Format format)
+{
+    if (format == CompactPcm::Format::Half)
+        return SimdOps::floatToHalf (x);
+
+    const auto scaled = std::lrint (juce::jlimit (-1.0f, 1.0f, x) * 32768.0f);
+    return (uint16_t) (int16_t) juce::jlimit (-32768L, 32767L, scaled);
+}
+
+std::shared_ptr<const CompactPcm> CompactPcm::fromBuffer (const juce::AudioBuffer<float>& stereo, Format format)
+{
+    std::shared_ptr<CompactPcm> pcm (new CompactPcm());
+    pcm->format = format;
+    pcm->numFrames = juce::jmax (0, stereo.getNumSamples());
+    if (pcm->numFrames == 0 || stereo.getNumChannels() < 1)
+        return pcm;
+
+    const float* src[2] = { stereo.getReadPointer (0),
+                            stereo.getReadPointer (juce::jmin (1, stereo.getNumChannels() - 1)) };
+    const int numChunks = (pcm->numFrames + kChunkMask) >> kChunkShift;
+
+    // Chunks whose right channel differs from the left need their own copy.
+    std::vector<bool> hasRight ((size_t) numChunks, false);
+    int numRightChunks = 0;
+    for (int c = 0; c < numChunks; ++c)
+    {
+        const int first = c << kChunkShift;
+        const int count = juce::jmin (kChunkFrames, pcm->numFrames - first);
+        if (! std::equal (src[0] + first, src[0] + first + count, src[1] + first))
+        {
+            hasRight[(size_t) c] = true;
+            ++numRightChunks;
+        }
+    }
+
+    pcm->storage.assign ((size_t) (numChunks + numRightChunks) * kChunkFrames, 0);
+    pcm->chunks[0].resize ((size_t) numChunks);
+    pcm->chunks[1].resize ((size_t) numChunks);
+
+    uint16_t* nextRight = pcm->storage.data() + (size_t) numChunks * kChunkFrames;
+    for (int c = 0; c < numChunks; ++c)
+    {
+        const int first = c << kChunkShift;
+        const int count = juce::jmin (kChunkFrames, pcm->numFrames - first);
+        uint16_t* left = pcm->storage.data() + (size_t) c * kChunkFrames;
+        for (int i = 0; i < count; ++i)
+            left[i] = encodeSample (src[0][first + i], format);
+
+        pcm->chunks[0][(size_t) c] = left;
+        pcm->chunks[1][(size_t) c] = left;
+
+        if (hasRight[(size_t) c])
+        {
+            for (int i = 0; i < count; ++i)
+                nextRight[i] = encodeSample (src[1][first + i], format);
+
+            pcm->chunks[1][(size_t) c] = nextRight;
+            nextRight += kChunkFrames;
+        }
+    }
+
+    return pcm;
+}
+
+void CompactPcm::read (int channel, int start, int count, float* dest) const noexcept
+{
+    const auto& channelChunks = chunks[(size_t) (channel > 0)];
+
+    while (count > 0)
+    {
+        const int offset = start & kChunkMask;
+        const int run = juce::jmin (count, kChunkFrames - offset);
+        const uint16_t* src = channelChunks[(size_t) (start >> kChunkShift)] + offset;
+
+        if (format == Format::Int16)
+            SimdOps::int16ToFloat (reinterpret_cast<const int16_t*> (src), dest, run);
+        else
+            SimdOps::halfToFloat (src, dest, run);
+
+        start += run;
+        dest += run;
+        count -= run;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "SimdOps.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Reduced-precision stereo session audio for compact storage mode: 16-bit
+// integer or IEEE half float. Audio is held in fixed-size chunks, and a chunk
+// whose channels are identical (any mono source) is stored once and read by
+// both channels, so mono material costs a quarter of planar float stereo.
+class CompactPcm
+{
+public:
+    enum class Format : int
+    {
+        Int16 = 1,
+        Half = 2,
+    };
+
+    static constexpr int kChunkShift = 12;
+    static constexpr int kChunkFrames = 1 << kChunkShift;
+    static constexpr int kChunkMask = kChunkFrames - 1;
+
+    // Encodes the first two channels of stereo (one is used for both if mono).
+    static std::shared_ptr<const CompactPcm> fromBuffer (const juce::AudioBuffer<float>& stereo, Format format);
+
+    Format getFormat() const { return format; }
+    int getNumFrames() const { return numFrames; }
+    size_t getNumBytes() const { return storage.size() * sizeof (uint16_t); }
+
+    // Any thread; frame must be in range.
+    float getSample (int frame, int channel) const noexcept
+    {
+        const uint16_t raw = chunks[(size_t) (channel > 0)][(size_t) (frame >> kChunkShift)][frame & kChunkMask];
+        return format == Format::Int16 ? (float) (int16_t) raw * (1.0f / 32768.0f)
+                                       : SimdOps::halfToFloat (raw);
+    }
+
+    // Converts frames [start, start + count) of channel to float with the SIMD
+    // kernels. The range must be in bounds.
+    void read (int channel, int start, int count, float* dest) const noexcept;
+
+private:
+    CompactPcm() = default;
+
+    Format format = Format::Int16;
+    int numFrames = 0;
+    std::vector<uint16_t> storage;   // every left chunk, then right chunks that differ
+    std::array<std::vector<const uint16_t*>, 2> chunks;
+};
@@ -0,0 +1,106 @@
+#include "DecodedRegionCache.h"
+#include <algorithm>
+
+DecodedRegionCache::DecodedRegionCache (size_t capacity)
+    : capacityBytes (capacity)
+{
+}
+
+DecodedRegionCache::Key DecodedRegionCache::makeKey (const juce::File& file, double sampleRate)
+{
+    Key key;
+    key.path = file.getFullPathName();
+    key.modificationTimeMs = file.getLastModificationTime().toMilliseconds();
+    key.fileSize = file.getSize();
+    key.sampleRate = sampleRate;
+    return key;
+}
+
+size_t DecodedRegionCache::bytesFor (const Region& region)
+{
+    // A mapped buffer is page cache rather than owned memory, but it still holds
+    // the file open and its address space, so it counts at its mapped size.
+    const auto numFrames = (size_t) region.buffer.getNumSamples();
+    size_t bytes = region.mapping != nullptr       ? region.mapping->getSize()
+                 : region.monoSamples != nullptr ? numFrames * sizeof (float)
+                                                 : (size_t) region.buffer.getNumChannels() * numFrames * sizeof (float);
+    if (region.sourcePcm != nullptr)
+        bytes += (size_t) region.sourcePcm->getNumChannels() * (size_t) region.sourcePcm->getNumSamples() * sizeof (float);
+    return bytes;
+}
+
+DecodedRegionCache::RegionPtr DecodedRegionCache::find (const juce::File& file, double sampleRate)
+{
+    const auto key = makeKey (file, sampleRate);
+
+    const juce::ScopedLock sl (lock);
+    auto it = std::find_if (entries.begin(), entries.end(),
+                            [&key] (const Entry& e) { return e.key == key; });
+    if (it == entries.end())
+        return nullptr;
+
+    entries.splice (entries.begin(), entries, it);
+    return entries.front().region;
+}
+
+void DecodedRegionCache::insert (const juce::File& file, double sampleRate, RegionPtr region)
+{
+    if (region == nullptr)
+        return;
+
+    Entry entry;
+    entry.key = makeKey (file, sampleRate);
+    entry.bytes = bytesFor (*region);
+    entry.region = std::move (region);
+
+    const juce::ScopedLock sl (lock);
+    if (entry.bytes > capacityBytes)
+        return;
+
+    auto it = std::find_if (entries.begin(), entries.end(),
+                            [&entry] (const Entry& e) { return e.key == entry.key; });
+    if (it != entries.end())
+    {
+        residentBytes -= it->bytes;
+        entries.erase (it);
+    }
+
+    residentBytes += entry.bytes;
+    entries.push_front (std::move (entry));
+    evictToCapacity();
+}
+
+void DecodedRegionCache::setCapacityBytes (size_t bytes)
+{
+    const juce::ScopedLock sl (lock);
+    capacityBytes = bytes;
+    evictToCapacity();
+}
+
+size_t DecodedRegionCache::getCapacityBytes() const
+{
+    const juce::ScopedLock sl (lock);
+    return capacityBytes;
+}
+
+size_t DecodedRegionCache::getResidentBytes() const
+{
+    const juce::ScopedLock sl (lock);
+    return residentBytes;
+}
+
+void DecodedRegionCache::clear()
+{
+    const juce::ScopedLock sl (lock);
+    entries.clear();
+    residentBytes = 0;
+}
+
+void DecodedRegionCache::evictToCapacity()
+{
+    while (residentBytes > capacityBytes && ! entries.empty())
+    {
+        residentBytes -= entries.back().bytes;
+        entries.pop_back();
+    }
+}
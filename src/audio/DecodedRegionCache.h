@@ -0,0 +1,89 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include <array>
+#include <list>
+#include <memory>
+
+// LRU cache of decoded, resampled files so that reorder, undo and redo rebuild
+// sessions from resident audio instead of re-reading and resampling from disk.
+// Entries are keyed by path, modification time, size and target rate, so an
+// edited file on disk misses. One cache serves every plugin instance in the
+// process (see juce::SharedResourcePointer), so the cap bounds them all.
+// Worker and message threads only.
+class DecodedRegionCache
+{
+public:
+    struct Region
+    {
+        juce::AudioBuffer<float> buffer;   // always stereo, at sampleRate
+        double sampleRate = 0.0;
+        int sourceNumFrames = 0;
+        double sourceSampleRate = 0.0;
+
+        // The file's own audio at sourceSampleRate, when the decode was asked to
+        // keep it and had to resample. Lets a host rate change skip the disk.
+        std::shared_ptr<const juce::AudioBuffer<float>> sourcePcm;
+
+        // A mono file at the target rate, read once and viewed by
+        // both channels of buffer.
+        juce::HeapBlock<float> monoSamples;
+
+        // Set when buffer views a disk cache entry in place rather than owning
+        // decoded memory. Entries are replaced by rename, never rewritten.
+        std::shared_ptr<const juce::MemoryMappedFile> mapping;
+
+        // buffer's channels, taken while the region is built so that sessions
+        // can view a shared region without casting away its constness.
+        std::array<float*, 2> channels {};
+
+        void takeChannels() { channels = { buffer.getWritePointer (0), buffer.getWritePointer (1) }; }
+    };
+
+    using RegionPtr = std::shared_ptr<const Region>;
+
+    static constexpr size_t kDefaultCapacityBytes = (size_t) 256 * 1024 * 1024;
+
+    explicit DecodedRegionCache (size_t capacityBytes = kDefaultCapacityBytes);
+
+    RegionPtr find (const juce::File& file, double sampleRate);
+    void insert (const juce::File& file, double sampleRate, RegionPtr region);
+
+    void setCapacityBytes (size_t bytes);
+    size_t getCapacityBytes() const;
+    size_t getResidentBytes() const;
+    void clear();
+
+private:
+    struct Key
+    {
+        juce::String path;
+        juce::int64 modificationTimeMs = 0;
+        juce::int64 fileSize = 0;
+        double sampleRate = 0.0;
+
+        bool operator== (const Key& other) const
+        {
+            return modificationTimeMs == other.modificationTimeMs
+                && fileSize == other.fileSize
+                && sampleRate == other.sampleRate
+                && path == other.path;
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        RegionPtr region;
+        size_t bytes = 0;
+    };
+
+    static Key makeKey (const juce::File& file, double sampleRate);
+    static size_t bytesFor (const Region& region);
+    void evictToCapacity();
+
+    juce::CriticalSection lock;
+    std::list<Entry> entries;   // most recently used first
+    size_t capacityBytes = kDefaultCapacityBytes;
+    size_t residentBytes = 0;
+};
@@ -0,0 +1,108 @@
+#include "DeferredReclaimer.h"
+
+DeferredReclaimer::DeferredReclaimer()
+    : juce::Thread ("DeferredReclaimer")
+{
+    for (size_t i = 0; i < cells.size(); ++i)
+        cells[i].sequence.store (i, std::memory_order_relaxed);
+
+    startThread (juce::Thread::Priority::background);
+}
+
+DeferredReclaimer::~DeferredReclaimer()
+{
+    stopThread (4000);
+    reclaimNow();
+}
+
+void DeferredReclaimer::reclaimNow()
+{
+    while (popAndFree()) {}
+}
+
+void DeferredReclaimer::run()
+{
+    while (! threadShouldExit())
+    {
+        reclaimNow();
+        wait (10);
+    }
+}
+
+void DeferredReclaimer::push (void* object, Deleter deleter, std::shared_ptr<const void> shared)
+{
+    numRetired.fetch_add (1, std::memory_order_relaxed);
+
+    size_t pos = enqueuePos.load (std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;)
+    {
+        cell = &cells[pos & kMask];
+        const size_t seq = cell->sequence.load (std::memory_order_acquire);
+        const auto diff = (intptr_t) seq - (intptr_t) pos;
+
+        if (diff == 0)
+        {
+            if (enqueuePos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            // Full: the reclaimer has fallen far behind, so pay for this one here.
+            if (deleter != nullptr)
+                deleter (object);
+            shared.reset();
+            numFreedInline.fetch_add (1, std::memory_order_release);
+            return;
+        }
+        else
+        {
+            pos = enqueuePos.load (std::memory_order_relaxed);
+        }
+    }
+
+    cell->object = object;
+    cell->deleter = deleter;
+    cell->shared = std::move (shared);
+    cell->sequence.store (pos + 1, std::memory_order_release);
+}
+
+bool DeferredReclaimer::popAndFree()
+{
+    size_t pos = dequeuePos.load (std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;)
+    {
+        cell = &cells[pos & kMask];
+        const size_t seq = cell->sequence.load (std::memory_order_acquire);
+        const auto diff = (intptr_t) seq - (intptr_t) (pos + 1);
+
+        if (diff == 0)
+        {
+            if (dequeuePos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            return false;   // empty
+        }
+        else
+        {
+            pos = dequeuePos.load (std::memory_order_relaxed);
+        }
+    }
+
+    void* object = cell->object;
+    const Deleter deleter = cell->deleter;
+    auto shared = std::move (cell->shared);
+    cell->object = nullptr;
+    cell->deleter = nullptr;
+    cell->sequence.store (pos + kMask + 1, std::memory_order_release);
+
+    if (deleter != nullptr)
+        deleter (object);
+    shared.reset();
+
+    numReclaimed.fetch_add (1, std::memory_order_release);
+    return true;
+}
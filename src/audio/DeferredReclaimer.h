@@ -0,0 +1,70 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Frees objects released on the audio thread from a background thread, so that
+// dropping a multi-MB sample or a load payload never runs a large free() inside
+// processBlock. retire() is lock-free and allocation-free and may be called from
+// any thread; if the queue is ever full the object is freed inline instead.
+class DeferredReclaimer : private juce::Thread
+{
+public:
+    static constexpr int kCapacity = 256;   // power of two
+
+    DeferredReclaimer();
+    ~DeferredReclaimer() override;
+
+    template <typename T>
+    void retire (std::unique_ptr<T> object)
+    {
+        if (object != nullptr)
+            push (object.release(), [] (void* p) { delete static_cast<T*> (p); }, {});
+    }
+
+    // Drops one reference; the object is destroyed here only if it was the last.
+    template <typename T>
+    void retire (std::shared_ptr<T> object)
+    {
+        if (object != nullptr)
+            push (nullptr, nullptr, std::shared_ptr<const void> (std::move (object)));
+    }
+
+    // Frees everything queued so far on the calling thread.
+    void reclaimNow();
+
+    // Totals since construction: retired = reclaimed + freedInline + still queued.
+    uint64_t getNumRetired() const     { return numRetired.load (std::memory_order_acquire); }
+    uint64_t getNumReclaimed() const   { return numReclaimed.load (std::memory_order_acquire); }
+    uint64_t getNumFreedInline() const { return numFreedInline.load (std::memory_order_acquire); }
+
+private:
+    using Deleter = void (*) (void*);
+
+    // Bounded multi-producer/multi-consumer ring (Vyukov): each cell's sequence
+    // says whether it is free for the producer or filled for the consumer.
+    struct Cell
+    {
+        std::atomic<size_t> sequence { 0 };
+        void* object = nullptr;
+        Deleter deleter = nullptr;
+        std::shared_ptr<const void> shared;
+    };
+
+    void run() override;
+    void push (void* object, Deleter deleter, std::shared_ptr<const void> shared);
+    bool popAndFree();
+
+    static constexpr size_t kMask = (size_t) kCapacity - 1;
+    static_assert ((kCapacity & (kCapacity - 1)) == 0);
+
+    std::array<Cell, kCapacity> cells;
+    alignas (64) std::atomic<size_t> enqueuePos { 0 };
+    alignas (64) std::atomic<size_t> dequeuePos { 0 };
+
+    std::atomic<uint64_t> numRetired { 0 };
+    std::atomic<uint64_t> numReclaimed { 0 };
+    std::atomic<uint64_t> numFreedInline { 0 };
+};
@@ -0,0 +1,298 @@
+#include "DiskDecodeCache.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <type_traits>
+
+namespace
+{
+constexpr uint32_t kEntryMagic = 0x43445849;   // "IXDC"
+constexpr uint32_t kEntryVersion = 1;
+constexpr juce::int64 kDataOffset = 128;       // header, padded so the audio is aligned
+const char* const kEntryExtension = ".idc";
+
+struct EntryHeader
+{
+    uint32_t magic = kEntryMagic;
+    uint32_t version = kEntryVersion;
+    uint64_t contentHash = 0;
+    double sampleRate = 0.0;
+    double sourceSampleRate = 0.0;
+    int32_t numFrames = 0;
+    int32_t sourceNumFrames = 0;
+    int32_t numChannels = 0;   // 1 when both channels are identical
+    int32_t samplesPerPeak[SampleData::kNumMipmapLevels] {};
+    int32_t numPeaks[SampleData::kNumMipmapLevels] {};
+};
+
+static_assert (sizeof (EntryHeader) <= (size_t) kDataOffset);
+static_assert (std::is_trivially_copyable_v<EntryHeader>);
+
+juce::int64 entryBytes (const EntryHeader& h)
+{
+    juce::int64 bytes = kDataOffset + (juce::int64) h.numChannels * h.numFrames * (juce::int64) sizeof (float);
+    for (int level = 0; level < SampleData::kNumMipmapLevels; ++level)
+        bytes += (juce::int64) 2 * h.numPeaks[level] * (juce::int64) sizeof (float);
+    return bytes;
+}
+
+inline uint64_t rotl (uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t fmix (uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+// 64-bit hash of a byte range, a word at a time with two independent lanes
+// (MurmurHash3-style mixing). Cache keying only, not cryptographic.
+uint64_t hashBytes (const uint8_t* data, size_t size)
+{
+    constexpr uint64_t c1 = 0x87c37b91114253d5ULL;
+    constexpr uint64_t c2 = 0x4cf5ad432745937fULL;
+    uint64_t h1 = 0x9e3779b97f4a7c15ULL;
+    uint64_t h2 = 0x2545f4914f6cdd1dULL;
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        uint64_t k1, k2;
+        std::memcpy (&k1, data + i, 8);
+        std::memcpy (&k2, data + i + 8, 8);
+
+        h1 ^= rotl (k1 * c1, 31) * c2;
+        h1 = rotl (h1, 27) * 5 + 0x52dce729;
+        h2 ^= rotl (k2 * c2, 33) * c1;
+        h2 = rotl (h2, 31) * 5 + 0x38495ab5;
+    }
+
+    uint64_t tail = 0;
+    std::memcpy (&tail, data + i, size - i);
+    h1 ^= rotl (tail * c1, 31) * c2;
+
+    h1 ^= (uint64_t) size;
+    h2 ^= (uint64_t) size;
+    return fmix (h1 + h2) ^ fmix (h2 + rotl (h1, 17));
+}
+
+// Content hash of file. Hashes are remembered per path, modification time and
+// size for the life of the process, so instances sharing files hash them once.
+bool contentHashOf (const juce::File& file, uint64_t& hash)
+{
+    struct Memo
+    {
+        juce::int64 modificationTimeMs = 0;
+        juce::int64 fileSize = 0;
+        uint64_t hash = 0;
+    };
+
+    static juce::CriticalSection memoLock;
+    static std::map<juce::String, Memo> memos;
+
+    const auto path = file.getFullPathName();
+    const auto modified = file.getLastModificationTime().toMilliseconds();
+    const auto size = file.getSize();
+    if (size <= 0)
+        return false;
+
+    {
+        const juce::ScopedLock sl (memoLock);
+        const auto it = memos.find (path);
+        if (it != memos.end() && it->second.modificationTimeMs == modified && it->second.fileSize == size)
+        {
+            hash = it->second.hash;
+            return true;
+        }
+    }
+
+    const juce::MemoryMappedFile mapping (file, juce::MemoryMappedFile::readOnly);
+    if (mapping.getData() == nullptr || (juce::int64) mapping.getSize() != size)
+        return false;
+
+    hash = hashBytes (static_cast<const uint8_t*> (mapping.getData()), mapping.getSize());
+
+    const juce::ScopedLock sl (memoLock);
+    memos[path] = { modified, size, hash };
+    return true;
+}
+} // namespace
+
+DiskDecodeCache::DiskDecodeCache (const juce::File& dir, juce::int64 capacity)
+    : directory (dir),
+      capacityBytes (capacity)
+{
+}
+
+juce::File DiskDecodeCache::entryFileFor (uint64_t contentHash, double sampleRate) const
+{
+    return directory.getChildFile (juce::String::toHexString ((juce::int64) contentHash).paddedLeft ('0', 16)
+                                   + "-" + juce::String (juce::roundToInt (sampleRate * 100.0))
+                                   + kEntryExtension);
+}
+
+DecodedRegionCache::RegionPtr DiskDecodeCache::find (const juce::File& file, double sampleRate,
+                                                     SampleData::PeakMipmaps& mipmaps)
+{
+    uint64_t contentHash = 0;
+    if (sampleRate <= 0.0 || ! contentHashOf (file, contentHash))
+        return nullptr;
+
+    const auto entryFile = entryFileFor (contentHash, sampleRate);
+    if (! entryFile.existsAsFile())
+        return nullptr;
+
+    auto mapping = std::make_shared<const juce::MemoryMappedFile> (entryFile, juce::MemoryMappedFile::readOnly);
+    auto* bytes = static_cast<char*> (mapping->getData());
+    if (bytes == nullptr || (juce::int64) mapping->getSize() < kDataOffset)
+        return nullptr;
+
+    EntryHeader header;
+    std::memcpy (&header, bytes, sizeof (header));
+    if (header.magic != kEntryMagic || header.version != kEntryVersion
+        || header.contentHash != contentHash || header.sampleRate != sampleRate
+        || header.numFrames <= 0 || (header.numChannels != 1 && header.numChannels != 2)
+        || entryBytes (header) != (juce::int64) mapping->getSize())
+        return nullptr;
+
+    auto* samples = reinterpret_cast<float*> (bytes + kDataOffset);
+    float* channels[2] = { samples, samples + (size_t) (header.numChannels - 1) * (size_t) header.numFrames };
+
+    auto region = std::make_shared<DecodedRegionCache::Region>();
+    region->buffer.setDataToReferTo (channels, 2, header.numFrames);
+    region->takeChannels();
+    region->sampleRate = header.sampleRate;
+    region->sourceNumFrames = header.sourceNumFrames;
+    region->sourceSampleRate = header.sourceSampleRate;
+
+    const float* peaks = samples + (size_t) header.numChannels * (size_t) header.numFrames;
+    for (int level = 0; level < SampleData::kNumMipmapLevels; ++level)
+    {
+        auto& m = mipmaps[(size_t) level];
+        const int n = header.numPeaks[level];
+        m.samplesPerPeak = header.samplesPerPeak[level];
+        m.maxPeaks.assign (peaks, peaks + n);
+        m.minPeaks.assign (peaks + n, peaks + 2 * n);
+        peaks += 2 * n;
+    }
+
+    region->mapping = std::move (mapping);
+    entryFile.setLastAccessTime (juce::Time::getCurrentTime());
+    return region;
+}
+
+void DiskDecodeCache::store (const juce::File& file, const DecodedRegionCache::Region& region,
+                             const SampleData::PeakMipmaps& mipmaps)
+{
+    const int numFrames = region.buffer.getNumSamples();
+    uint64_t contentHash = 0;
+    if (numFrames <= 0 || region.buffer.getNumChannels() < 2 || region.sampleRate <= 0.0
+        || ! contentHashOf (file, contentHash))
+        return;
+
+    const float* left = region.buffer.getReadPointer (0);
+    const float* right = region.buffer.getReadPointer (1);
+    const bool mono = left == right || std::equal (left, left + numFrames, right);
+
+    EntryHeader header;
+    header.contentHash = contentHash;
+    header.sampleRate = region.sampleRate;
+    header.sourceSampleRate = region.sourceSampleRate;
+    header.numFrames = numFrames;
+    header.sourceNumFrames = region.sourceNumFrames;
+    header.numChannels = mono ? 1 : 2;
+    for (int level = 0; level < SampleData::kNumMipmapLevels; ++level)
+    {
+        const auto& m = mipmaps[(size_t) level];
+        header.samplesPerPeak[level] = m.samplesPerPeak;
+        header.numPeaks[level] = (int32_t) juce::jmin (m.maxPeaks.size(), m.minPeaks.size());
+    }
+
+    if (entryBytes (header) > getCapacityBytes() || directory.createDirectory().failed())
+        return;
+
+    // Written under a temporary name and moved into place, so neither another
+    // instance nor a crash can leave a partial entry behind the real name.
+    const auto entryFile = entryFileFor (contentHash, region.sampleRate);
+    juce::TemporaryFile temp (entryFile);
+    bool written = false;
+    {
+        juce::FileOutputStream out (temp.getFile());
+        if (! out.failedToOpen())
+        {
+            char padded[kDataOffset] {};
+            std::memcpy (padded, &header, sizeof (header));
+            written = out.write (padded, sizeof (padded))
+                   && out.write (left, (size_t) numFrames * sizeof (float))
+                   && (mono || out.write (right, (size_t) numFrames * sizeof (float)));
+
+            for (int level = 0; written && level < SampleData::kNumMipmapLevels; ++level)
+            {
+                const auto& m = mipmaps[(size_t) level];
+                const auto n = (size_t) header.numPeaks[level];
+                written = out.write (m.maxPeaks.data(), n * sizeof (float))
+                       && out.write (m.minPeaks.data(), n * sizeof (float));
+            }
+
+            out.flush();
+            written = written && out.getStatus().wasOk();
+        }
+    }
+
+    if (! written || ! temp.overwriteTargetFileWithTemporary())
+        return;
+
+    trimToCapacity();
+}
+
+void DiskDecodeCache::setCapacityBytes (juce::int64 bytes)
+{
+    capacityBytes.store (juce::jmax ((juce::int64) 0, bytes), std::memory_order_relaxed);
+    trimToCapacity();
+}
+
+void DiskDecodeCache::clear()
+{
+    const juce::ScopedLock sl (trimLock);
+    for (const auto& entry : directory.findChildFiles (juce::File::findFiles, false, juce::String ("*") + kEntryExtension))
+        entry.deleteFile();
+}
+
+void DiskDecodeCache::trimToCapacity()
+{
+    const juce::ScopedLock sl (trimLock);
+
+    struct Candidate
+    {
+        juce::File file;
+        juce::int64 bytes = 0;
+        juce::Time lastUsed;
+    };
+
+    std::vector<Candidate> candidates;
+    juce::int64 total = 0;
+    for (const auto& entry : directory.findChildFiles (juce::File::findFiles, false, juce::String ("*") + kEntryExtension))
+    {
+        candidates.push_back ({ entry, entry.getSize(), entry.getLastAccessTime() });
+        total += candidates.back().bytes;
+    }
+
+    const auto capacity = getCapacityBytes();
+    if (total <= capacity)
+        return;
+
+    std::sort (candidates.begin(), candidates.end(),
+               [] (const Candidate& a, const Candidate& b) { return a.lastUsed < b.lastUsed; });
+
+    // An entry still mapped somewhere may refuse deletion (Windows); skip it.
+    for (const auto& c : candidates)
+    {
+        if (total <= capacity)
+            break;
+        if (c.file.deleteFile())
+            total -= c.bytes;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "DecodedRegionCache.h"
+#include "SampleData.h"
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cstdint>
+
+// Opt-in on-disk cache of decoded files, so that reopening a project skips
+// decoding and resampling. An entry holds one file's stereo float audio at one
+// target rate plus its peak mipmaps, keyed by a hash of the file's contents and
+// that rate, and a hit is memory-mapped rather than read. The directory is
+// trimmed to a size budget, least recently used first, and may be shared by
+// several instances. Worker and message threads only.
+class DiskDecodeCache
+{
+public:
+    static constexpr juce::int64 kDefaultCapacityBytes = (juce::int64) 4 * 1024 * 1024 * 1024;
+
+    explicit DiskDecodeCache (const juce::File& directory, juce::int64 capacityBytes = kDefaultCapacityBytes);
+
+    const juce::File& getDirectory() const { return directory; }
+
+    // Maps the entry for file at sampleRate, or returns nullptr. On a hit the
+    // file's peaks are copied into mipmaps.
+    DecodedRegionCache::RegionPtr find (const juce::File& file, double sampleRate,
+                                        SampleData::PeakMipmaps& mipmaps);
+
+    // Writes region (at its own sampleRate) with the file's peaks, then trims.
+    void store (const juce::File& file, const DecodedRegionCache::Region& region,
+                const SampleData::PeakMipmaps& mipmaps);
+
+    void setCapacityBytes (juce::int64 bytes);
+    juce::int64 getCapacityBytes() const { return capacityBytes.load (std::memory_order_relaxed); }
+
+    // Deletes every entry that is not currently mapped.
+    void clear();
+
+private:
+    juce::File entryFileFor (uint64_t contentHash, double sampleRate) const;
+    void trimToCapacity();
+
+    const juce::File directory;
+    std::atomic<juce::int64> capacityBytes;
+    juce::CriticalSection trimLock;
+};
@@ -0,0 +1,30 @@
+#include "InterleavedFrames.h"
+
+std::shared_ptr<const InterleavedFrames> InterleavedFrames::fromBuffer (const juce::AudioBuffer<float>& stereo)
+{
+    std::shared_ptr<InterleavedFrames> frames (new InterleavedFrames());
+    frames->numFrames = juce::jmax (0, stereo.getNumSamples());
+    if (frames->numFrames == 0 || stereo.getNumChannels() < 1)
+    {
+        frames->numFrames = 0;
+        return frames;
+    }
+
+    constexpr size_t kPadFloats = kAlignment / sizeof (float);
+    frames->storage.resize ((size_t) frames->numFrames * 2 + kPadFloats);
+
+    auto* base = frames->storage.data();
+    const auto misalignment = reinterpret_cast<uintptr_t> (base) % kAlignment;
+    float* dest = base + (misalignment == 0 ? 0 : (kAlignment - misalignment) / sizeof (float));
+    frames->data = dest;
+
+    const float* left = stereo.getReadPointer (0);
+    const float* right = stereo.getReadPointer (juce::jmin (1, stereo.getNumChannels() - 1));
+    for (int i = 0; i < frames->numFrames; ++i)
+    {
+        dest[2 * (size_t) i] = left[i];
+        dest[2 * (size_t) i + 1] = right[i];
+    }
+
+    return frames;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Stereo session audio laid out as L/R frame pairs in one 64-byte-aligned
+// block, so every tap of an interpolated stereo read shares the cache lines
+// of its neighbours. Built alongside the planar buffer of float sessions for
+// the audio thread's per-sample repitch reads.
+class InterleavedFrames
+{
+public:
+    static constexpr size_t kAlignment = 64;
+
+    // Interleaves the first two channels of stereo (one is used for both if mono).
+    static std::shared_ptr<const InterleavedFrames> fromBuffer (const juce::AudioBuffer<float>& stereo);
+
+    int getNumFrames() const { return numFrames; }
+    size_t getNumBytes() const { return storage.size() * sizeof (float); }
+
+    // Frame f is at getData()[2 * f] (left) and getData()[2 * f + 1] (right).
+    const float* getData() const { return data; }
+
+private:
+    InterleavedFrames() = default;
+
+    int numFrames = 0;
+    std::vector<float> storage;   // over-allocated so data can start on a boundary
+    const float* data = nullptr;
+};
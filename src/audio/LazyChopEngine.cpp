@@ -1,11 +1,10 @@
 #include "LazyChopEngine.h"
 #include "../Constants.h"
-#include "AudioAnalysis.h"
 #include <cmath>
 
 void LazyChopEngine::start (int sampleLen, SliceManager& sliceMgr,
                             const PreviewStretchParams& params,
-                            bool snap, const juce::AudioBuffer<float>* buf)
+                            bool snap, const SampleData* sample)
 {
     active = true;
     playing = false;
@@ -14,7 +13,7 @@ void LazyChopEngine::start (int sampleLen, SliceManager& sliceMgr,
     lastNote = -1;
     cachedParams = params;
     snapEnabled = snap;
-    sampleBuffer = buf;
+    sampleData = sample;
 
     nextMidiNote = sliceMgr.rootNote.load();
     int num = sliceMgr.getNumSlices();
@@ -34,7 +33,7 @@ void LazyChopEngine::startPreview (VoicePool& voicePool, int fromPos)
 
     // Apply stretch from cached sample-level params
     const auto& p = cachedParams;
-    VoicePool::initPreviewVoiceStretch (v, fromPos, p);
+    voicePool.initPreviewVoiceStretch (v, fromPos, p);
 
     // Sustain at half volume
     v.envelope.noteOn (0.0f, 0.0f, 0.5f, 0.02f, cachedParams.sampleRate);
@@ -91,8 +90,8 @@ int LazyChopEngine::onNote (int note, VoicePool& voicePool, SliceManager& sliceM
     auto& v = voicePool.getVoice (getPreviewVoiceIndex());
     int playhead = (int) std::floor (v.position);
 
-    if (snapEnabled && sampleBuffer != nullptr)
-        playhead = AudioAnalysis::findNearestZeroCrossing (*sampleBuffer, playhead);
+    if (snapEnabled && sampleData != nullptr)
+        playhead = sampleData->findNearestZeroCrossing (playhead);
 
     // After audition, first unassigned note just sets a new start point
     if (chopPos < 0)
@@ -13,7 +13,7 @@ public:
     int  getChopPos() const { return chopPos; }
 
     void start (int sampleLen, SliceManager& sliceMgr, const PreviewStretchParams& params,
-                bool snap = false, const juce::AudioBuffer<float>* buf = nullptr);
+                bool snap = false, const SampleData* sample = nullptr);
     void stop (VoicePool& voicePool, SliceManager& sliceMgr);
     int  onNote (int note, VoicePool& voicePool, SliceManager& sliceMgr);
 
@@ -32,5 +32,5 @@ private:
     PreviewStretchParams cachedParams;
 
     bool snapEnabled = false;
-    const juce::AudioBuffer<float>* sampleBuffer = nullptr;
+    const SampleData* sampleData = nullptr;
 };
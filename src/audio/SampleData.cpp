@@ -1,6 +1,10 @@
 #include "SampleData.h"
+#include "SampleStreamer.h"
+#include "DiskDecodeCache.h"
+#include "AudioAnalysis.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <memory>
 
 namespace
@@ -9,8 +13,12 @@ namespace
 static const juce::AudioBuffer<float> kEmptyBuffer;
 static const std::array<SampleData::PeakMipmap, SampleData::kNumMipmapLevels> kEmptyMipmaps;
 
+// reuse/reuseFrames: mipmaps already built for the first reuseFrames of src.
+// Their complete peak blocks are copied; only the rest is scanned.
 void buildMipmapsForBuffer (const juce::AudioBuffer<float>& src,
-                            std::array<SampleData::PeakMipmap, SampleData::kNumMipmapLevels>& outMipmaps)
+                            std::array<SampleData::PeakMipmap, SampleData::kNumMipmapLevels>& outMipmaps,
+                            const std::array<SampleData::PeakMipmap, SampleData::kNumMipmapLevels>* reuse = nullptr,
+                            int reuseFrames = 0)
 {
     int numFrames = src.getNumSamples();
     if (numFrames <= 0 || src.getNumChannels() < 1)
@@ -39,7 +47,20 @@ void buildMipmapsForBuffer (const juce::AudioBuffer<float>& src,
         m.maxPeaks.resize ((size_t) numPeaks);
         m.minPeaks.resize ((size_t) numPeaks);
 
-        for (int i = 0; i < numPeaks; ++i)
+        int firstPeak = 0;
+        if (reuse != nullptr)
+        {
+            const auto& prior = (*reuse)[(size_t) level];
+            if (prior.samplesPerPeak == m.samplesPerPeak)
+            {
+                firstPeak = std::min ({ juce::jmax (0, reuseFrames) / m.samplesPerPeak, numPeaks,
+                                        (int) prior.maxPeaks.size(), (int) prior.minPeaks.size() });
+                std::copy_n (prior.maxPeaks.begin(), firstPeak, m.maxPeaks.begin());
+                std::copy_n (prior.minPeaks.begin(), firstPeak, m.minPeaks.begin());
+            }
+        }
+
+        for (int i = firstPeak; i < numPeaks; ++i)
         {
             int start = i * m.samplesPerPeak;
             int end = std::min (start + m.samplesPerPeak, numFrames);
@@ -60,122 +81,706 @@ void buildMipmapsForBuffer (const juce::AudioBuffer<float>& src,
 
 SampleData::SampleData() = default;
 
+void SampleData::DecodedSample::readFrames (int channel, int start, int count, float* dest) const
+{
+    if (compact != nullptr)
+        compact->read (channel, start, count, dest);
+    else
+        std::copy_n (buffer.getReadPointer (juce::jmin (channel, buffer.getNumChannels() - 1)) + start, count, dest);
+}
+
+juce::AudioBuffer<float> SampleData::DecodedSample::copyFrames (int start, int count) const
+{
+    start = juce::jlimit (0, getNumFrames(), start);
+    count = juce::jlimit (0, getNumFrames() - start, count);
+
+    juce::AudioBuffer<float> copy (2, count);
+    if (count > 0)
+        for (int ch = 0; ch < 2; ++ch)
+            readFrames (ch, start, count, copy.getWritePointer (ch));
+    return copy;
+}
+
+// Puts a freshly built float session into its storage format: Interleaved
+// sessions gain an interleaved copy, compact ones move into CompactPcm. Mipmaps are
+// built from the float data first, so only the audio itself loses precision.
+// Zero crossings are indexed last, from the stored audio, so snaps match what
+// plays. Streamed sessions keep their spill file and are only indexed.
+static void applyStorage (SampleData::DecodedSample& decoded, SampleData::Storage storage)
+{
+    if (decoded.buffer.getNumSamples() <= 0)
+        return;
+
+    if (decoded.stream == nullptr && storage == SampleData::Storage::Interleaved)
+    {
+        decoded.frames = InterleavedFrames::fromBuffer (decoded.buffer);
+    }
+    else if (decoded.stream == nullptr && storage != SampleData::Storage::Float32)
+    {
+        decoded.compact = CompactPcm::fromBuffer (decoded.buffer, (CompactPcm::Format) storage);
+        decoded.buffer = juce::AudioBuffer<float>();
+        decoded.backing.reset();
+    }
+
+    const auto& stored = decoded;
+    decoded.zeroCrossings = ZeroCrossingIndex::build (stored.getNumFrames(),
+                                                      [&stored] (int channel, int start, int count, float* dest)
+                                                      {
+                                                          stored.readFrames (channel, start, count, dest);
+                                                      });
+}
+
 std::unique_ptr<SampleData::DecodedSample> SampleData::decodeFromFile (const juce::File& file,
                                                                         double projectSampleRate)
 {
     return decodeFromFiles (std::vector<juce::File> { file }, projectSampleRate);
 }
 
-std::unique_ptr<SampleData::DecodedSample> SampleData::decodeFromFiles (const std::vector<juce::File>& files,
-                                                                        double projectSampleRate,
-                                                                        const std::vector<int>* sampleIds)
+static bool needsResample (double sourceRate, double targetRate)
 {
-    if (files.empty())
+    return std::abs (sourceRate - targetRate) > 0.01;
+}
+
+// Length of sourceFrames at sourceRate once converted to targetRate.
+static int framesAtRate (int sourceFrames, double sourceRate, double targetRate)
+{
+    return needsResample (sourceRate, targetRate) ? (int) std::ceil (sourceFrames / (sourceRate / targetRate))
+                                                  : sourceFrames;
+}
+
+// Converts source (any channel count) to stereo at targetRate.
+static juce::AudioBuffer<float> toStereoAtRate (const juce::AudioBuffer<float>& source,
+                                                double sourceRate, double targetRate)
+{
+    const int numChannels = juce::jmax (1, source.getNumChannels());
+    const bool resample = needsResample (sourceRate, targetRate);
+    const double ratio = sourceRate / targetRate;
+    const int numFrames = framesAtRate (source.getNumSamples(), sourceRate, targetRate);
+
+    juce::AudioBuffer<float> stereo (2, numFrames);
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        const int sourceCh = juce::jmin (ch, numChannels - 1);
+        if (ch > 0 && sourceCh == 0)
+        {
+            stereo.copyFrom (ch, 0, stereo, 0, 0, numFrames);
+        }
+        else if (resample)
+        {
+            juce::LagrangeInterpolator interpolator;
+            interpolator.process (ratio, source.getReadPointer (sourceCh), stereo.getWritePointer (ch), numFrames);
+        }
+        else
+        {
+            stereo.copyFrom (ch, 0, source, sourceCh, 0, numFrames);
+        }
+    }
+    return stereo;
+}
+
+// Fast path: a mono file already at the target rate is read once into a single
+// channel that both sides of the stereo buffer view.
+static DecodedRegionCache::RegionPtr readMonoRegion (juce::AudioFormatReader& reader)
+{
+    if (reader.numChannels != 1 || reader.lengthInSamples <= 0)
+        return nullptr;
+
+    const auto numFrames = (int) reader.lengthInSamples;
+    auto region = std::make_shared<DecodedRegionCache::Region>();
+    region->monoSamples.malloc ((size_t) numFrames);
+
+    float* const dest[1] = { region->monoSamples.get() };
+    if (! reader.read (dest, 1, 0, numFrames))
         return nullptr;
 
+    float* channels[2] = { region->monoSamples.get(), region->monoSamples.get() };
+    region->buffer.setDataToReferTo (channels, 2, numFrames);
+    region->takeChannels();
+    region->sampleRate = reader.sampleRate;
+    region->sourceNumFrames = numFrames;
+    region->sourceSampleRate = reader.sampleRate;
+    return region;
+}
+
+// Decodes one file to stereo at targetRate (the file's own rate when targetRate <= 0).
+static DecodedRegionCache::RegionPtr decodeRegion (juce::AudioFormatManager& fm, const juce::File& file,
+                                                   double targetRate, bool retainSourcePcm)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader (fm.createReaderFor (file));
+    if (reader == nullptr)
+        return nullptr;
+
+    const auto numFrames = (int) reader->lengthInSamples;
+    const auto numChannels = (int) reader->numChannels;
+    const double sourceSampleRate = reader->sampleRate > 0.0 ? reader->sampleRate : 44100.0;
+    if (targetRate <= 0.0)
+        targetRate = sourceSampleRate;
+
+    if (! needsResample (sourceSampleRate, targetRate))
+        if (auto mono = readMonoRegion (*reader))
+            return mono;
+
+    auto region = std::make_shared<DecodedRegionCache::Region>();
+    region->sampleRate = targetRate;
+    region->sourceNumFrames = numFrames;
+    region->sourceSampleRate = sourceSampleRate;
+
+    // At the target rate the reader fills the stereo buffer directly (mono is
+    // duplicated, extra channels dropped): one pass, one allocation.
+    if (! needsResample (sourceSampleRate, targetRate))
+    {
+        region->buffer.setSize (2, numFrames, false, false, true);
+        reader->read (&region->buffer, 0, numFrames, 0, true, true);
+        region->takeChannels();
+        return region;
+    }
+
+    juce::AudioBuffer<float> sourceBuffer (juce::jmax (1, numChannels), numFrames);
+    reader->read (&sourceBuffer, 0, numFrames, 0, true, true);
+
+    region->buffer = toStereoAtRate (sourceBuffer, sourceSampleRate, targetRate);
+    region->takeChannels();
+    if (retainSourcePcm)
+        region->sourcePcm = std::make_shared<const juce::AudioBuffer<float>> (std::move (sourceBuffer));
+
+    return region;
+}
+
+// Looks the file up in the memory cache, then the disk cache, before decoding
+// it, and caches fresh decodes in both. peaks, when given, receives the file's
+// own mipmaps whenever the disk cache had or needed them.
+static DecodedRegionCache::RegionPtr loadRegion (juce::AudioFormatManager& fm, const juce::File& file,
+                                                 double targetRate, DecodedRegionCache* cache,
+                                                 DiskDecodeCache* diskCache, bool retainSourcePcm,
+                                                 SampleData::PeakMipmaps* peaks = nullptr)
+{
+    // Without a target rate the file sets it, so only cache once it is known.
+    if (cache != nullptr && targetRate > 0.0)
+        if (auto region = cache->find (file, targetRate))
+            if (! retainSourcePcm || region->sourcePcm != nullptr
+                || ! needsResample (region->sourceSampleRate, region->sampleRate))
+                return region;
+
+    // Disk entries carry no source-rate audio; a later host rate change
+    // reloads those files rather than resampling from memory.
+    if (diskCache != nullptr && targetRate > 0.0)
+    {
+        SampleData::PeakMipmaps cachedPeaks;
+        if (auto region = diskCache->find (file, targetRate, cachedPeaks))
+        {
+            if (cache != nullptr)
+                cache->insert (file, region->sampleRate, region);
+            if (peaks != nullptr)
+                *peaks = std::move (cachedPeaks);
+            return region;
+        }
+    }
+
+    auto region = decodeRegion (fm, file, targetRate, retainSourcePcm);
+    if (region == nullptr)
+        return nullptr;
+
+    // Mono float files read straight in as fast as an entry would load.
+    if (diskCache != nullptr && region->monoSamples == nullptr)
+    {
+        SampleData::PeakMipmaps freshPeaks;
+        buildMipmapsForBuffer (region->buffer, freshPeaks);
+        diskCache->store (file, *region, freshPeaks);
+        if (peaks != nullptr)
+            *peaks = std::move (freshPeaks);
+    }
+
+    if (cache != nullptr)
+        cache->insert (file, region->sampleRate, region);
+    return region;
+}
+
+// Where one file sits in a session: its length at the session rate, and its source.
+struct RegionPlan
+{
+    int numFrames = 0;
+    int sourceNumFrames = 0;
+    double sourceSampleRate = 0.0;
+};
+
+static RegionPlan planOf (const DecodedRegionCache::Region& region)
+{
+    return { region.buffer.getNumSamples(), region.sourceNumFrames, region.sourceSampleRate };
+}
+
+// Lays out a session from file headers alone, before anything decodes.
+// Empty if a file cannot be opened.
+static std::vector<RegionPlan> planRegions (const std::vector<juce::File>& files, double targetRate)
+{
     juce::AudioFormatManager fm;
     fm.registerBasicFormats();
 
-    auto decoded = std::make_unique<DecodedSample>();
+    std::vector<RegionPlan> plans;
+    for (const auto& file : files)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader (fm.createReaderFor (file));
+        if (reader == nullptr)
+            return {};
+
+        const double sourceRate = reader->sampleRate > 0.0 ? reader->sampleRate : 44100.0;
+        const auto sourceFrames = (int) reader->lengthInSamples;
+        plans.push_back ({ framesAtRate (sourceFrames, sourceRate, targetRate), sourceFrames, sourceRate });
+    }
+    return plans;
+}
+
+// Stitches regions end to end into a session. A null region (a file still
+// decoding) takes its planned length and reads as silence, and marks the
+// result partial.
+static std::unique_ptr<SampleData::DecodedSample> assembleSession (const std::vector<juce::File>& files,
+                                                                   const std::vector<int>* sampleIds,
+                                                                   const std::vector<DecodedRegionCache::RegionPtr>& regions,
+                                                                   const std::vector<RegionPlan>& plans,
+                                                                   double targetSampleRate)
+{
+    auto decoded = std::make_unique<SampleData::DecodedSample>();
     int totalFrames = 0;
-    double targetSampleRate = 0.0;
     int totalSourceFrames = 0;
     double firstSourceSampleRate = 0.0;
-
-    struct DecodedRegion
-    {
-        juce::AudioBuffer<float> buffer;
-        SessionSample meta;
-    };
-
-    std::vector<DecodedRegion> regions;
-    regions.reserve (files.size());
+    bool complete = true;
 
     for (size_t i = 0; i < files.size(); ++i)
     {
         const auto& file = files[i];
-        std::unique_ptr<juce::AudioFormatReader> reader (fm.createReaderFor (file));
-        if (reader == nullptr)
-            return nullptr;
+        const auto& region = regions[i];
+        const auto plan = region != nullptr ? planOf (*region) : plans[i];
+        complete = complete && region != nullptr;
 
-        auto numFrames = (int) reader->lengthInSamples;
-        auto numChannels = (int) reader->numChannels;
-        const int sourceNumFrames = numFrames;
-        const double sourceSampleRate = reader->sampleRate > 0.0 ? reader->sampleRate : 44100.0;
-        if (targetSampleRate <= 0.0)
-            targetSampleRate = projectSampleRate > 0.0 ? projectSampleRate : sourceSampleRate;
         if (firstSourceSampleRate <= 0.0)
-            firstSourceSampleRate = sourceSampleRate;
+            firstSourceSampleRate = plan.sourceSampleRate;
+
+        SampleData::SessionSample meta;
+        meta.sampleId = sampleIds != nullptr && i < sampleIds->size() ? (*sampleIds)[i] : (int) i;
+        meta.fileName = file.getFileName();
+        meta.filePath = file.getFullPathName();
+        meta.startFrame = totalFrames;
+        meta.numFrames = plan.numFrames;
+        meta.sourceNumFrames = plan.sourceNumFrames;
+        meta.sourceSampleRate = plan.sourceSampleRate;
+        decoded->sessionSamples.push_back (meta);
+        decoded->sourcePcm.push_back (region != nullptr ? region->sourcePcm : nullptr);
 
-        juce::AudioBuffer<float> sourceBuffer (juce::jmax (1, numChannels), numFrames);
-        reader->read (&sourceBuffer, 0, numFrames, 0, true, true);
+        totalFrames += plan.numFrames;
+        totalSourceFrames += plan.sourceNumFrames;
+    }
+
+    if (regions.size() == 1 && complete)
+    {
+        // A single file is the whole session: view its region (owned or mapped)
+        // rather than copying it. Snapshots are const, so nothing writes through.
+        const auto& region = regions.front();
+        float* channels[2] = { region->channels[0], region->channels[1] };
+        decoded->buffer.setDataToReferTo (channels, 2, totalFrames);
+        decoded->backing = region;
+    }
+    else
+    {
+        decoded->buffer.setSize (2, totalFrames);
+        if (! complete)
+            decoded->buffer.clear();
 
-        if (std::abs (sourceSampleRate - targetSampleRate) > 0.01)
+        for (size_t i = 0; i < regions.size(); ++i)
         {
-            const double ratio = sourceSampleRate / targetSampleRate;
-            const int resampledLen = (int) std::ceil (numFrames / ratio);
-            juce::AudioBuffer<float> resampledBuffer (juce::jmax (1, numChannels), resampledLen);
+            const auto& region = regions[i];
+            if (region == nullptr)
+                continue;
 
-            for (int ch = 0; ch < numChannels; ++ch)
+            const int writePos = decoded->sessionSamples[i].startFrame;
+            const int regionFrames = region->buffer.getNumSamples();
+            decoded->buffer.copyFrom (0, writePos, region->buffer, 0, 0, regionFrames);
+            decoded->buffer.copyFrom (1, writePos, region->buffer, 1, 0, regionFrames);
+        }
+    }
+
+    if (! decoded->sessionSamples.empty())
+    {
+        decoded->fileName = decoded->sessionSamples.front().fileName;
+        decoded->filePath = decoded->sessionSamples.front().filePath;
+    }
+    decoded->decodedNumFrames = totalFrames;
+    decoded->decodedSampleRate = targetSampleRate;
+    decoded->sourceNumFrames = totalSourceFrames;
+    decoded->sourceSampleRate = firstSourceSampleRate;
+    decoded->partial = ! complete;
+    return decoded;
+}
+
+namespace
+{
+// Work shared between the decoding thread and its pool helpers. Files are
+// claimed by index, so each region lands in its own slot and stitching stays
+// in file order however the decodes interleave. Helpers hold a reference, so
+// ones that start after the caller has returned just find nothing to do.
+struct ParallelDecode
+{
+    std::vector<juce::File> files;
+    double targetRate = 0.0;
+    DecodedRegionCache* cache = nullptr;
+    DiskDecodeCache* diskCache = nullptr;
+    bool retainSourcePcm = false;
+    std::function<bool()> shouldCancel;
+    std::function<void (int, int)> onFileDecoded;
+    int firstFileDone = 0;   // decoded by the caller before the parallel phase
+
+    std::vector<DecodedRegionCache::RegionPtr> regions;
+    SampleData::PeakMipmaps firstPeaks;   // of files[0], when it is the session's first file
+    std::atomic<int> nextIndex { 0 };
+    std::atomic<int> numFinished { 0 };
+    std::atomic<bool> abandoned { false };
+    juce::WaitableEvent allFinished;
+
+    // Progressive loads only (onPartial set): the planned layout, and which
+    // regions have landed. The rest is guarded by partialLock.
+    std::function<void (std::unique_ptr<SampleData::DecodedSample>)> onPartial;
+    std::vector<RegionPlan> plans;
+    std::vector<int> sampleIds;
+    std::unique_ptr<std::atomic<bool>[]> ready;
+    juce::CriticalSection partialLock;
+    bool planBroken = false;                // a file decoded to another length than planned
+    int publishedFrames = 0;                // leading frames of the last partial
+    juce::uint32 lastPublishMs = 0;
+    SampleData::PeakMipmaps publishedPeaks; // of the last partial
+
+    static constexpr juce::uint32 kPartialIntervalMs = 250;
+
+    // Publishes the leading run of decoded files as a partial session. After
+    // the first, a partial goes out only once that run has doubled, so a load
+    // copies the session a logarithmic number of times. A thread that finds
+    // another one publishing just carries on decoding.
+    void publishPartial()
+    {
+        const juce::ScopedTryLock stl (partialLock);
+        if (! stl.isLocked() || planBroken)
+            return;
+
+        const int numFiles = (int) files.size();
+        std::vector<DecodedRegionCache::RegionPtr> leading ((size_t) numFiles);
+        int numReady = 0;
+        int readyFrames = 0;
+        while (numReady < numFiles && ready[(size_t) numReady].load (std::memory_order_acquire))
+        {
+            const auto& region = regions[(size_t) numReady];
+            if (region->buffer.getNumSamples() != plans[(size_t) numReady].numFrames)
             {
-                juce::LagrangeInterpolator interpolator;
-                interpolator.process (ratio,
-                                      sourceBuffer.getReadPointer (ch),
-                                      resampledBuffer.getWritePointer (ch),
-                                      resampledLen);
+                planBroken = true;
+                return;
             }
 
-            sourceBuffer = std::move (resampledBuffer);
-            numFrames = resampledLen;
+            leading[(size_t) numReady] = region;
+            readyFrames += plans[(size_t) numReady].numFrames;
+            ++numReady;
         }
 
-        juce::AudioBuffer<float> stereoBuffer (2, numFrames);
-        if (numChannels >= 2)
+        // The complete session is the caller's to publish.
+        if (numReady == 0 || numReady == numFiles)
+            return;
+
+        const auto now = juce::Time::getMillisecondCounter();
+        if (publishedFrames > 0 && (readyFrames < 2 * publishedFrames || now - lastPublishMs < kPartialIntervalMs))
+            return;
+
+        auto partial = assembleSession (files, &sampleIds, leading, plans, targetRate);
+        if (publishedFrames > 0)
+            buildMipmapsForBuffer (partial->buffer, partial->peakMipmaps, &publishedPeaks, publishedFrames);
+        else
+            buildMipmapsForBuffer (partial->buffer, partial->peakMipmaps, &firstPeaks, plans.front().numFrames);
+
+        publishedPeaks = partial->peakMipmaps;
+        publishedFrames = readyFrames;
+        lastPublishMs = now;
+        onPartial (std::move (partial));
+    }
+
+    void work()
+    {
+        const int numFiles = (int) files.size();
+        std::unique_ptr<juce::AudioFormatManager> fm;
+
+        for (;;)
         {
-            stereoBuffer.copyFrom (0, 0, sourceBuffer, 0, 0, numFrames);
-            stereoBuffer.copyFrom (1, 0, sourceBuffer, 1, 0, numFrames);
+            const int i = nextIndex.fetch_add (1, std::memory_order_relaxed);
+            if (i >= numFiles)
+                return;
+
+            if (! abandoned.load (std::memory_order_relaxed)
+                && ! (shouldCancel && shouldCancel()))
+            {
+                if (fm == nullptr)
+                {
+                    fm = std::make_unique<juce::AudioFormatManager>();
+                    fm->registerBasicFormats();
+                }
+
+                regions[(size_t) i] = loadRegion (*fm, files[(size_t) i], targetRate, cache, diskCache, retainSourcePcm,
+                                                  i == 0 && firstFileDone == 0 ? &firstPeaks : nullptr);
+                if (regions[(size_t) i] == nullptr)
+                {
+                    abandoned.store (true, std::memory_order_relaxed);
+                }
+                else if (onPartial)
+                {
+                    ready[(size_t) i].store (true, std::memory_order_release);
+                    if (! (shouldCancel && shouldCancel()))
+                        publishPartial();
+                }
+            }
+            else
+            {
+                abandoned.store (true, std::memory_order_relaxed);
+            }
+
+            const int done = numFinished.fetch_add (1, std::memory_order_acq_rel) + 1;
+            if (onFileDecoded && ! abandoned.load (std::memory_order_relaxed))
+                onFileDecoded (firstFileDone + done, firstFileDone + numFiles);
+            if (done == numFiles)
+                allFinished.signal();
         }
-        else
+    }
+};
+} // namespace
+
+// Writes one file's audio at targetRate straight into a spill file's channels,
+// a block at a time, so streaming a long file never holds it in memory.
+static bool streamRegionInto (juce::AudioFormatReader& reader, double targetRate,
+                              float* destL, float* destR, int outFrames,
+                              const std::function<bool()>& shouldCancel)
+{
+    constexpr int kOutBlock = 16384;
+
+    const int numChannels = juce::jmax (1, (int) reader.numChannels);
+    const double sourceRate = reader.sampleRate > 0.0 ? reader.sampleRate : 44100.0;
+    const bool resample = needsResample (sourceRate, targetRate);
+    const double ratio = sourceRate / targetRate;
+    const int rightCh = juce::jmin (1, numChannels - 1);
+
+    // Lagrange reads a few frames past the ones it consumes.
+    const int capacity = resample ? (int) std::ceil (kOutBlock * ratio) + 16 : kOutBlock;
+    juce::AudioBuffer<float> staging (numChannels, capacity);
+    juce::LagrangeInterpolator interpolators[2];
+    juce::int64 readPos = 0;
+    int staged = 0;
+
+    for (int outPos = 0; outPos < outFrames; outPos += kOutBlock)
+    {
+        if (shouldCancel && shouldCancel())
+            return false;
+
+        const int numOut = juce::jmin (kOutBlock, outFrames - outPos);
+        if (! resample)
         {
-            stereoBuffer.copyFrom (0, 0, sourceBuffer, 0, 0, numFrames);
-            stereoBuffer.copyFrom (1, 0, sourceBuffer, 0, 0, numFrames);
+            // Reads past the end of the file come back as silence.
+            reader.read (&staging, 0, numOut, readPos, true, true);
+            std::copy_n (staging.getReadPointer (0), numOut, destL + outPos);
+            std::copy_n (staging.getReadPointer (rightCh), numOut, destR + outPos);
+            readPos += numOut;
+            continue;
         }
 
-        DecodedRegion region;
-        region.buffer = std::move (stereoBuffer);
-        region.meta.sampleId = sampleIds != nullptr && i < sampleIds->size() ? (*sampleIds)[i] : (int) i;
-        region.meta.fileName = file.getFileName();
-        region.meta.filePath = file.getFullPathName();
-        region.meta.startFrame = totalFrames;
-        region.meta.numFrames = numFrames;
-        region.meta.sourceNumFrames = sourceNumFrames;
-        region.meta.sourceSampleRate = sourceSampleRate;
-        totalFrames += numFrames;
-        totalSourceFrames += sourceNumFrames;
-        regions.push_back (std::move (region));
+        const int toRead = capacity - staged;
+        reader.read (&staging, staged, toRead, readPos, true, true);
+        readPos += toRead;
+        staged = capacity;
+
+        const int used = interpolators[0].process (ratio, staging.getReadPointer (0), destL + outPos, numOut);
+        if (rightCh > 0)
+            interpolators[1].process (ratio, staging.getReadPointer (rightCh), destR + outPos, numOut);
+        else
+            std::copy_n (destL + outPos, numOut, destR + outPos);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = staging.getWritePointer (ch);
+            std::copy (data + used, data + staged, data);
+        }
+        staged -= used;
     }
 
-    decoded->buffer.setSize (2, totalFrames);
-    int writePos = 0;
-    for (auto& region : regions)
+    return true;
+}
+
+// Streaming-mode decode: the session is laid out in a disk-backed spill file
+// and the returned sample's buffer views its mapping.
+static std::unique_ptr<SampleData::DecodedSample> decodeToStream (const std::vector<juce::File>& files,
+                                                                  double projectSampleRate,
+                                                                  const std::vector<int>* sampleIds,
+                                                                  const SampleData::DecodeOptions& options)
+{
+    juce::AudioFormatManager fm;
+    fm.registerBasicFormats();
+
+    std::vector<std::unique_ptr<juce::AudioFormatReader>> readers;
+    std::vector<int> regionFrames;
+    double targetSampleRate = projectSampleRate > 0.0 ? projectSampleRate : 0.0;
+    juce::int64 totalFrames = 0;
+
+    for (const auto& file : files)
     {
-        const int regionFrames = region.buffer.getNumSamples();
-        decoded->buffer.copyFrom (0, writePos, region.buffer, 0, 0, regionFrames);
-        decoded->buffer.copyFrom (1, writePos, region.buffer, 1, 0, regionFrames);
-        decoded->sessionSamples.push_back (region.meta);
-        writePos += regionFrames;
+        std::unique_ptr<juce::AudioFormatReader> reader (fm.createReaderFor (file));
+        if (reader == nullptr)
+            return nullptr;
+
+        const double sourceRate = reader->sampleRate > 0.0 ? reader->sampleRate : 44100.0;
+        if (targetSampleRate <= 0.0)
+            targetSampleRate = sourceRate;
+
+        const auto sourceFrames = (int) reader->lengthInSamples;
+        const int frames = framesAtRate (sourceFrames, sourceRate, targetSampleRate);
+        regionFrames.push_back (frames);
+        totalFrames += frames;
+        readers.push_back (std::move (reader));
     }
 
-    if (! decoded->sessionSamples.empty())
+    if (totalFrames <= 0 || totalFrames > std::numeric_limits<int>::max())
+        return nullptr;
+
+    auto stream = SampleStream::create (options.streamDirectory, (int) totalFrames);
+    if (stream == nullptr)
+        return nullptr;
+
+    auto decoded = std::make_unique<SampleData::DecodedSample>();
+    float* channels[2] = { stream->getChannel (0), stream->getChannel (1) };
+    int writePos = 0;
+    int totalSourceFrames = 0;
+
+    for (size_t i = 0; i < files.size(); ++i)
     {
-        decoded->fileName = decoded->sessionSamples.front().fileName;
-        decoded->filePath = decoded->sessionSamples.front().filePath;
+        auto& reader = *readers[i];
+        if (! streamRegionInto (reader, targetSampleRate, channels[0] + writePos, channels[1] + writePos,
+                                regionFrames[i], options.shouldCancel))
+            return nullptr;
+
+        SampleData::SessionSample meta;
+        meta.sampleId = sampleIds != nullptr && i < sampleIds->size() ? (*sampleIds)[i] : (int) i;
+        meta.fileName = files[i].getFileName();
+        meta.filePath = files[i].getFullPathName();
+        meta.startFrame = writePos;
+        meta.numFrames = regionFrames[i];
+        meta.sourceNumFrames = (int) reader.lengthInSamples;
+        meta.sourceSampleRate = reader.sampleRate > 0.0 ? reader.sampleRate : 44100.0;
+        decoded->sessionSamples.push_back (meta);
+
+        writePos += regionFrames[i];
+        totalSourceFrames += meta.sourceNumFrames;
+        readers[i].reset();
+
+        if (options.onFileDecoded)
+            options.onFileDecoded ((int) i + 1, (int) files.size());
     }
-    decoded->decodedNumFrames = totalFrames;
+
+    decoded->buffer.setDataToReferTo (channels, 2, writePos);
+    decoded->sourcePcm.resize (decoded->sessionSamples.size());
+    decoded->stream = std::move (stream);
+    decoded->fileName = decoded->sessionSamples.front().fileName;
+    decoded->filePath = decoded->sessionSamples.front().filePath;
+    decoded->decodedNumFrames = writePos;
     decoded->decodedSampleRate = targetSampleRate;
     decoded->sourceNumFrames = totalSourceFrames;
-    decoded->sourceSampleRate = firstSourceSampleRate;
+    decoded->sourceSampleRate = decoded->sessionSamples.front().sourceSampleRate;
     buildMipmapsForBuffer (decoded->buffer, decoded->peakMipmaps);
+    applyStorage (*decoded, Storage::Float32);
+    return decoded;
+}
+
+std::unique_ptr<SampleData::DecodedSample> SampleData::decodeFromFiles (const std::vector<juce::File>& files,
+                                                                        double projectSampleRate,
+                                                                        const std::vector<int>* sampleIds,
+                                                                        const DecodeOptions& options)
+{
+    if (files.empty())
+        return nullptr;
+
+    if (options.streamDirectory != juce::File())
+        return decodeToStream (files, projectSampleRate, sampleIds, options);
+
+    const int numFiles = (int) files.size();
+    std::vector<DecodedRegionCache::RegionPtr> regions ((size_t) numFiles);
+    double targetSampleRate = projectSampleRate > 0.0 ? projectSampleRate : 0.0;
+    int firstFileDone = 0;
+    PeakMipmaps firstPeaks;   // the first file's own, when the disk cache had or built them
+
+    // Without a project rate the first file sets it for the rest.
+    if (targetSampleRate <= 0.0)
+    {
+        if (options.shouldCancel && options.shouldCancel())
+            return nullptr;
+
+        juce::AudioFormatManager fm;
+        fm.registerBasicFormats();
+        regions[0] = loadRegion (fm, files[0], targetSampleRate, options.cache, options.diskCache.get(),
+                                 options.retainSourcePcm, &firstPeaks);
+        if (regions[0] == nullptr)
+            return nullptr;
+
+        targetSampleRate = regions[0]->sampleRate;
+        firstFileDone = 1;
+        if (options.onFileDecoded)
+            options.onFileDecoded (1, numFiles);
+    }
+
+    std::shared_ptr<ParallelDecode> job;
+    if (firstFileDone < numFiles)
+    {
+        job = std::make_shared<ParallelDecode>();
+        job->files.assign (files.begin() + firstFileDone, files.end());
+        job->targetRate = targetSampleRate;
+        job->cache = options.cache;
+        job->diskCache = options.diskCache.get();
+        job->retainSourcePcm = options.retainSourcePcm;
+        job->shouldCancel = options.shouldCancel;
+        job->onFileDecoded = options.onFileDecoded;
+        job->firstFileDone = firstFileDone;
+        job->regions.resize (job->files.size());
+
+        // Progressive: the session layout must be known up front, so only
+        // when the rate is. Falls back to a plain load if a header won't read.
+        if (options.onPartialDecoded && firstFileDone == 0 && numFiles > 1)
+        {
+            job->plans = planRegions (files, targetSampleRate);
+            if (! job->plans.empty())
+            {
+                job->onPartial = options.onPartialDecoded;
+                if (sampleIds != nullptr)
+                    job->sampleIds = *sampleIds;
+                job->ready = std::make_unique<std::atomic<bool>[]> ((size_t) numFiles);
+                for (int i = 0; i < numFiles; ++i)
+                    job->ready[(size_t) i].store (false, std::memory_order_relaxed);
+            }
+        }
+
+        const int remaining = (int) job->files.size();
+        const int numHelpers = options.pool != nullptr
+                                   ? juce::jmin (options.pool->getNumThreads(), remaining - 1)
+                                   : 0;
+        for (int h = 0; h < numHelpers; ++h)
+            options.pool->addJob ([job] { job->work(); });
+
+        job->work();
+        job->allFinished.wait (-1);
+
+        if (job->abandoned.load (std::memory_order_acquire))
+            return nullptr;
+
+        std::copy (job->regions.begin(), job->regions.end(), regions.begin() + firstFileDone);
+        if (firstFileDone == 0)
+            firstPeaks = std::move (job->firstPeaks);
+    }
+
+    auto decoded = assembleSession (files, sampleIds, regions, {}, targetSampleRate);
+
+    // The session starts with the first file, so its complete peak blocks carry
+    // over; after a partial, so does everything that partial had decoded. Every
+    // publish finished before its file counted as done, so job is settled here.
+    if (job != nullptr && job->publishedFrames > 0 && ! job->planBroken)
+        buildMipmapsForBuffer (decoded->buffer, decoded->peakMipmaps, &job->publishedPeaks, job->publishedFrames);
+    else
+        buildMipmapsForBuffer (decoded->buffer, decoded->peakMipmaps,
+                               &firstPeaks, regions.front()->buffer.getNumSamples());
+    applyStorage (*decoded, options.storage);
     return decoded;
 }
 
@@ -204,8 +809,8 @@ std::unique_ptr<SampleData::DecodedSample> SampleData::rebuildWithSessionSamples
     int writePos = 0;
     for (const auto& sample : sessionSamples)
     {
-        const int sourceStart = juce::jlimit (0, source.buffer.getNumSamples(), sample.startFrame);
-        const int availableFrames = juce::jmax (0, source.buffer.getNumSamples() - sourceStart);
+        const int sourceStart = juce::jlimit (0, source.getNumFrames(), sample.startFrame);
+        const int availableFrames = juce::jmax (0, source.getNumFrames() - sourceStart);
         const int copyFrames = juce::jmin (juce::jmax (0, sample.numFrames), availableFrames);
 
         SampleData::SessionSample rebuiltSample = sample;
@@ -213,10 +818,16 @@ std::unique_ptr<SampleData::DecodedSample> SampleData::rebuildWithSessionSamples
         rebuiltSample.numFrames = copyFrames;
         rebuilt->sessionSamples.push_back (rebuiltSample);
 
+        SourcePcmPtr pcm;
+        for (size_t i = 0; i < source.sessionSamples.size() && i < source.sourcePcm.size(); ++i)
+            if (source.sessionSamples[i].sampleId == sample.sampleId)
+                pcm = source.sourcePcm[i];
+        rebuilt->sourcePcm.push_back (std::move (pcm));
+
         if (copyFrames > 0)
         {
-            rebuilt->buffer.copyFrom (0, writePos, source.buffer, 0, sourceStart, copyFrames);
-            rebuilt->buffer.copyFrom (1, writePos, source.buffer, 1, sourceStart, copyFrames);
+            source.readFrames (0, sourceStart, copyFrames, rebuilt->buffer.getWritePointer (0, writePos));
+            source.readFrames (1, sourceStart, copyFrames, rebuilt->buffer.getWritePointer (1, writePos));
             writePos += copyFrames;
         }
     }
@@ -228,22 +839,153 @@ std::unique_ptr<SampleData::DecodedSample> SampleData::rebuildWithSessionSamples
     }
 
     buildMipmapsForBuffer (rebuilt->buffer, rebuilt->peakMipmaps);
+    applyStorage (*rebuilt, source.getStorage());
     return rebuilt;
 }
 
+bool SampleData::canResampleFromSource (const DecodedSample& source)
+{
+    // Copying a streamed session would pull all of it into RAM, and a partial
+    // one is about to be replaced anyway.
+    if (source.stream != nullptr || source.partial)
+        return false;
+
+    for (size_t i = 0; i < source.sessionSamples.size(); ++i)
+    {
+        const bool hasPcm = i < source.sourcePcm.size() && source.sourcePcm[i] != nullptr;
+        if (! hasPcm && needsResample (source.sessionSamples[i].sourceSampleRate, source.decodedSampleRate))
+            return false;
+    }
+    return ! source.sessionSamples.empty();
+}
+
+std::unique_ptr<SampleData::DecodedSample> SampleData::resampleFromSource (const DecodedSample& source,
+                                                                           double targetRate)
+{
+    if (targetRate <= 0.0 || ! canResampleFromSource (source))
+        return nullptr;
+
+    auto resampled = std::make_unique<DecodedSample>();
+    std::vector<juce::AudioBuffer<float>> regions;
+    regions.reserve (source.sessionSamples.size());
+
+    int totalFrames = 0;
+    for (size_t i = 0; i < source.sessionSamples.size(); ++i)
+    {
+        const auto& sample = source.sessionSamples[i];
+        auto pcm = i < source.sourcePcm.size() ? source.sourcePcm[i] : nullptr;
+
+        if (pcm == nullptr)
+        {
+            // Already at its source rate: this region of the buffer is the source.
+            pcm = std::make_shared<const juce::AudioBuffer<float>> (source.copyFrames (sample.startFrame,
+                                                                                     juce::jmax (0, sample.numFrames)));
+        }
+
+        regions.push_back (toStereoAtRate (*pcm, sample.sourceSampleRate, targetRate));
+        const int numFrames = regions.back().getNumSamples();
+
+        SessionSample resampledSample = sample;
+        resampledSample.startFrame = totalFrames;
+        resampledSample.numFrames = numFrames;
+        resampled->sessionSamples.push_back (resampledSample);
+        resampled->sourcePcm.push_back (needsResample (sample.sourceSampleRate, targetRate) ? pcm : nullptr);
+        totalFrames += numFrames;
+    }
+
+    resampled->buffer.setSize (2, totalFrames);
+    int writePos = 0;
+    for (const auto& region : regions)
+    {
+        const int regionFrames = region.getNumSamples();
+        resampled->buffer.copyFrom (0, writePos, region, 0, 0, regionFrames);
+        resampled->buffer.copyFrom (1, writePos, region, 1, 0, regionFrames);
+        writePos += regionFrames;
+    }
+
+    resampled->fileName = source.fileName;
+    resampled->filePath = source.filePath;
+    resampled->decodedNumFrames = totalFrames;
+    resampled->decodedSampleRate = targetRate;
+    resampled->sourceNumFrames = source.sourceNumFrames;
+    resampled->sourceSampleRate = source.sourceSampleRate;
+    buildMipmapsForBuffer (resampled->buffer, resampled->peakMipmaps);
+    applyStorage (*resampled, source.getStorage());
+    return resampled;
+}
+
+std::unique_ptr<SampleData::DecodedSample> SampleData::appendToSession (const DecodedSample& base,
+                                                                        const DecodedSample& appended)
+{
+    auto spliced = std::make_unique<DecodedSample>();
+
+    const int baseFrames = base.getNumFrames();
+    const int appendedFrames = appended.getNumFrames();
+    const int totalFrames = baseFrames + appendedFrames;
+
+    spliced->buffer.setSize (2, totalFrames);
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        if (baseFrames > 0)
+            base.readFrames (ch, 0, baseFrames, spliced->buffer.getWritePointer (ch));
+        if (appendedFrames > 0)
+            appended.readFrames (ch, 0, appendedFrames, spliced->buffer.getWritePointer (ch, baseFrames));
+    }
+
+    spliced->sessionSamples.reserve (base.sessionSamples.size() + appended.sessionSamples.size());
+    spliced->sessionSamples = base.sessionSamples;
+    for (auto sample : appended.sessionSamples)
+    {
+        sample.startFrame += baseFrames;
+        spliced->sessionSamples.push_back (sample);
+    }
+
+    spliced->sourcePcm = base.sourcePcm;
+    spliced->sourcePcm.resize (base.sessionSamples.size());
+    spliced->sourcePcm.insert (spliced->sourcePcm.end(), appended.sourcePcm.begin(), appended.sourcePcm.end());
+    spliced->sourcePcm.resize (spliced->sessionSamples.size());
+
+    spliced->fileName = base.fileName;
+    spliced->filePath = base.filePath;
+    spliced->decodedNumFrames = totalFrames;
+    spliced->decodedSampleRate = base.decodedSampleRate;
+    spliced->sourceNumFrames = base.sourceNumFrames + appended.sourceNumFrames;
+    spliced->sourceSampleRate = base.sourceSampleRate;
+
+    // The base's complete peak blocks are unchanged; only its last partial block
+    // and the appended region need scanning.
+    buildMipmapsForBuffer (spliced->buffer, spliced->peakMipmaps, &base.peakMipmaps, baseFrames);
+    applyStorage (*spliced, base.getStorage());
+    return spliced;
+}
+
 void SampleData::applyDecodedSample (std::unique_ptr<DecodedSample> decoded)
 {
     if (decoded == nullptr)
         return;
 
-    const int frames = decoded->decodedNumFrames > 0 ? decoded->decodedNumFrames
-                                                     : decoded->buffer.getNumSamples();
+    decoded->generation = ++lastGeneration;
+    if (decoded->generation == 0)
+        decoded->generation = ++lastGeneration;
 
     // Convert to shared_ptr — no buffer copy, no heap allocation.
-    auto shared = std::shared_ptr<const DecodedSample> (decoded.release());
+    applySnapshot (std::shared_ptr<const DecodedSample> (decoded.release()));
+}
+
+void SampleData::applySnapshot (SnapshotPtr shared)
+{
+    if (shared == nullptr)
+        return;
+
+    const int frames = shared->decodedNumFrames > 0 ? shared->decodedNumFrames
+                                                    : shared->getNumFrames();
 
     // Audio-thread reference (non-atomic, only written here on audio thread).
+    auto replaced = std::move (activeDecoded);
     activeDecoded = shared;
+    activeStream = streamer != nullptr ? shared->stream.get() : nullptr;
+    activeCompact = shared->compact.get();
+    activeFrames = shared->frames.get();
     numFrames.store (frames, std::memory_order_release);
     decodedSampleRate.store (shared->decodedSampleRate, std::memory_order_release);
     sourceNumFrames.store (shared->sourceNumFrames, std::memory_order_release);
@@ -256,11 +998,16 @@ void SampleData::applyDecodedSample (std::unique_ptr<DecodedSample> decoded)
     std::atomic_store_explicit (&snapshot, shared, std::memory_order_release);
 #endif
     loaded.store (true, std::memory_order_release);
+
+    retireReplaced (std::move (replaced));
 }
 
 void SampleData::clear()
 {
-    activeDecoded.reset();
+    auto replaced = std::move (activeDecoded);
+    activeStream = nullptr;
+    activeCompact = nullptr;
+    activeFrames = nullptr;
     numFrames.store (0, std::memory_order_release);
 #if INTERSECT_HAS_STD_ATOMIC_SHARED_PTR
     snapshot.store (std::shared_ptr<const DecodedSample> {}, std::memory_order_release);
@@ -272,6 +1019,15 @@ void SampleData::clear()
     decodedSampleRate.store (0.0, std::memory_order_release);
     sourceNumFrames.store (0, std::memory_order_release);
     sourceSampleRate.store (0.0, std::memory_order_release);
+
+    retireReplaced (std::move (replaced));
+}
+
+void SampleData::retireReplaced (SnapshotPtr replaced)
+{
+    // Held until the snapshot above has moved on, so neither store frees it.
+    if (replaced != nullptr && reclaimer != nullptr)
+        reclaimer->retire (std::move (replaced));
 }
 
 SampleData::SnapshotPtr SampleData::getSnapshot() const
@@ -336,11 +1092,15 @@ float SampleData::getSampleAtFrame (int frame, int channel) const
     if (! activeDecoded || channel < 0 || channel > 1)
         return 0.0f;
 
-    const auto& buf = activeDecoded->buffer;
-    if (frame < 0 || frame >= buf.getNumSamples())
+    if (frame < 0 || frame >= activeDecoded->getNumFrames())
         return 0.0f;
 
-    auto* data = buf.getReadPointer (channel);
+    if (activeStream != nullptr)
+        return streamer->readFrame (*activeStream, frame, channel);
+    if (activeCompact != nullptr)
+        return activeCompact->getSample (frame, channel);
+
+    auto* data = activeDecoded->buffer.getReadPointer (channel);
     return data != nullptr ? data[frame] : 0.0f;
 }
 
@@ -349,13 +1109,23 @@ float SampleData::getInterpolatedSample (double pos, int channel) const
     if (! activeDecoded || channel < 0 || channel > 1)
         return 0.0f;
 
-    const auto& buf = activeDecoded->buffer;
+    const int frames = activeDecoded->getNumFrames();
     int ipos = (int) pos;
     float frac = (float) (pos - ipos);
 
-    if (ipos < 0 || ipos >= buf.getNumSamples())
+    if (ipos < 0 || ipos >= frames)
         return 0.0f;
-    if (ipos == buf.getNumSamples() - 1)
+
+    if (activeStream != nullptr || activeCompact != nullptr)
+    {
+        const float s0 = getSampleAtFrame (ipos, channel);
+        if (ipos == frames - 1)
+            return s0;
+        return s0 + (getSampleAtFrame (ipos + 1, channel) - s0) * frac;
+    }
+
+    const auto& buf = activeDecoded->buffer;
+    if (ipos == frames - 1)
     {
         auto* data = buf.getReadPointer (channel);
         return data != nullptr ? data[ipos] : 0.0f;
@@ -366,3 +1136,29 @@ float SampleData::getInterpolatedSample (double pos, int channel) const
         return 0.0f;
     return data[ipos] + (data[ipos + 1] - data[ipos]) * frac;
 }
+
+int SampleData::findNearestZeroCrossing (const DecodedSample& sample, int pos, int searchRange)
+{
+    if (sample.zeroCrossings != nullptr)
+        return sample.zeroCrossings->findNearest (pos, searchRange);
+
+    if (sample.compact == nullptr)
+        return AudioAnalysis::findNearestZeroCrossing (sample.buffer, pos, searchRange);
+
+    const auto& pcm = *sample.compact;
+    return AudioAnalysis::findNearestZeroCrossingIn (pcm.getNumFrames(), pos,
+                                                     [&pcm] (int i) { return (pcm.getSample (i, 0) + pcm.getSample (i, 1)) * 0.5f; },
+                                                     searchRange);
+}
+
+int SampleData::findNearestZeroCrossing (int pos) const
+{
+    if (activeDecoded == nullptr)
+        return pos;
+
+    if (activeStream != nullptr && activeDecoded->zeroCrossings == nullptr)
+        return AudioAnalysis::findNearestZeroCrossingIn (activeDecoded->getNumFrames(), pos,
+                                                         [this] (int i) { return (getSampleAtFrame (i, 0) + getSampleAtFrame (i, 1)) * 0.5f; });
+
+    return findNearestZeroCrossing (*activeDecoded, pos);
+}
@@ -2,8 +2,15 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_audio_formats/juce_audio_formats.h>
 #include "StemSeparation.h"
+#include "DeferredReclaimer.h"
+#include "DecodedRegionCache.h"
+#include "SampleStream.h"
+#include "CompactPcm.h"
+#include "InterleavedFrames.h"
+#include "ZeroCrossingIndex.h"
 #include <atomic>
 #include <array>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -13,6 +20,9 @@
 #define INTERSECT_HAS_STD_ATOMIC_SHARED_PTR 0
 #endif
 
+class SampleStreamer;
+class DiskDecodeCache;
+
 class SampleData
 {
 public:
@@ -26,6 +36,7 @@ public:
     };
 
     static constexpr int kNumMipmapLevels = 3;
+    using PeakMipmaps = std::array<PeakMipmap, kNumMipmapLevels>;
 
     struct SessionSample
     {
@@ -39,9 +50,24 @@ public:
         StemMetadata stemMeta;
     };
 
+    // How decoded session audio is held in memory. Compact formats are chosen
+    // per instance and trade precision for a half to a quarter of the RAM.
+    // Interleaved is Float32 plus an interleaved copy for faster per-sample
+    // repitch reads, at twice the RAM.
+    enum class Storage : int
+    {
+        Float32 = 0,
+        Int16 = 1,
+        Half = 2,
+        Interleaved = 3,
+    };
+
+    // Source-rate audio of one session sample, in the file's channel layout.
+    using SourcePcmPtr = std::shared_ptr<const juce::AudioBuffer<float>>;
+
     struct DecodedSample
     {
-        juce::AudioBuffer<float> buffer;  // always stereo
+        juce::AudioBuffer<float> buffer;  // always stereo; empty when compact is set
         std::array<PeakMipmap, kNumMipmapLevels> peakMipmaps;
         juce::String fileName;
         juce::String filePath;
@@ -50,25 +76,152 @@ public:
         int sourceNumFrames = 0;
         double sourceSampleRate = 0.0;
         std::vector<SessionSample> sessionSamples;
+        // Parallel to sessionSamples. Null where nothing was retained or where the
+        // sample is already at its source rate (buffer itself is then the source).
+        std::vector<SourcePcmPtr> sourcePcm;
+        // Set when buffer views a disk-backed spill file instead of owned memory.
+        std::shared_ptr<SampleStream> stream;
+        // Keeps alive other memory buffer views without owning it: the cached,
+        // possibly file-mapped, region of a single-file session.
+        std::shared_ptr<const void> backing;
+        // Set in compact storage mode, in place of buffer's float data.
+        std::shared_ptr<const CompactPcm> compact;
+        // Interleaved copy of buffer for per-sample stereo reads (Interleaved storage only).
+        std::shared_ptr<const InterleavedFrames> frames;
+        // Sign changes of the mono mix, for zero-crossing snaps (absent while partial).
+        std::shared_ptr<const ZeroCrossingIndex> zeroCrossings;
+        uint32_t generation = 0;  // stamped by applyDecodedSample; identifies this buffer to caches
+        // Only the leading files are decoded yet; the rest of the (full-length)
+        // session reads as silence until the complete sample replaces this one.
+        bool partial = false;
+
+        int getNumFrames() const { return compact != nullptr ? compact->getNumFrames() : buffer.getNumSamples(); }
+        Storage getStorage() const
+        {
+            if (compact != nullptr)
+                return (Storage) compact->getFormat();
+            return frames != nullptr ? Storage::Interleaved : Storage::Float32;
+        }
+
+        // Reads from whichever storage is in use; frame must be in range.
+        float getSample (int frame, int channel) const
+        {
+            return compact != nullptr ? compact->getSample (frame, channel)
+                                      : buffer.getSample (juce::jmin (channel, buffer.getNumChannels() - 1), frame);
+        }
+
+        // Copies frames [start, start + count) of channel as float; must be in range.
+        void readFrames (int channel, int start, int count, float* dest) const;
+
+        // Stereo float copy of frames [start, start + count), clamped to the sample.
+        juce::AudioBuffer<float> copyFrames (int start, int count) const;
     };
 
     using SnapshotPtr = std::shared_ptr<const DecodedSample>;
 
     SampleData();
 
+    struct DecodeOptions
+    {
+        // Files already decoded at the target rate are copied from the cache and
+        // fresh decodes are added to it.
+        DecodedRegionCache* cache = nullptr;
+
+        // When set, files are looked up on disk (after cache) before decoding,
+        // and fresh decodes are written there for later sessions.
+        std::shared_ptr<DiskDecodeCache> diskCache;
+
+        // Helper threads for multi-file loads. The calling thread decodes too, so
+        // a busy or single-threaded pool only costs parallelism.
+        juce::ThreadPool* pool = nullptr;
+
+        // Keep source-rate audio of resampled files for resampleFromSource().
+        bool retainSourcePcm = false;
+
+        // When set, decode into a disk-backed spill file in this directory
+        // (streaming mode); the caches, pool, retainSourcePcm and storage are not used.
+        juce::File streamDirectory;
+
+        // Format the session is held in once decoded.
+        Storage storage = Storage::Float32;
+
+        // Polled before each file; returning true abandons the decode (nullptr).
+        std::function<bool()> shouldCancel;
+
+        // Called from whichever thread finished the file, never after return.
+        std::function<void (int filesDone, int filesTotal)> onFileDecoded;
+
+        // Progressive loads: handed partial sessions (see DecodedSample::partial)
+        // as leading files finish, from a decode thread, never after return.
+        // Used only for multi-file, non-streamed loads with a known target rate.
+        std::function<void (std::unique_ptr<DecodedSample>)> onPartialDecoded;
+    };
+
     static std::unique_ptr<DecodedSample> decodeFromFile (const juce::File& file,
                                                            double projectSampleRate);
     static std::unique_ptr<DecodedSample> decodeFromFiles (const std::vector<juce::File>& files,
                                                            double projectSampleRate,
-                                                           const std::vector<int>* sampleIds = nullptr);
+                                                           const std::vector<int>* sampleIds = nullptr,
+                                                           const DecodeOptions& options = {});
     static std::unique_ptr<DecodedSample> rebuildWithSessionSamples (const DecodedSample& source,
                                                                      const std::vector<SessionSample>& sessionSamples);
 
+    // True when every sample can be resampled from memory: it has retained
+    // source PCM or is already at its source rate.
+    static bool canResampleFromSource (const DecodedSample& source);
+
+    // Rebuilds source at targetRate without touching disk. Returns nullptr
+    // unless canResampleFromSource (source).
+    static std::unique_ptr<DecodedSample> resampleFromSource (const DecodedSample& source,
+                                                              double targetRate);
+
+    // Splices appended (decoded at base's rate) after base, shifting its region
+    // offsets and reusing base's mipmaps.
+    static std::unique_ptr<DecodedSample> appendToSession (const DecodedSample& base,
+                                                           const DecodedSample& appended);
+
     // Audio-thread safe: converts unique_ptr to shared_ptr (no buffer copy).
     void applyDecodedSample (std::unique_ptr<DecodedSample> decoded);
 
+    // Makes an already-shared sample active without restamping its generation.
+    // Used by worker-private instances that render from a UI snapshot.
+    void applySnapshot (SnapshotPtr shared);
+
     void clear();
 
+    // Replaced samples are handed to reclaimer instead of being freed by the
+    // caller of applyDecodedSample / clear. Set once before playback starts.
+    void setReclaimer (DeferredReclaimer* r) { reclaimer = r; }
+
+    // Audio-thread reads of streamed samples go through streamer's chunk pool
+    // instead of the spill mapping. Set once before playback starts.
+    void setStreamer (const SampleStreamer* s) { streamer = s; }
+
+    // Audio-thread only — true when the active sample is streamed.
+    bool isStreaming() const { return activeStream != nullptr; }
+
+    // Audio-thread only — the active sample's compact storage, or nullptr.
+    const CompactPcm* getCompact() const { return activeCompact; }
+
+    // Audio-thread only — false when the active sample is streamed or compact,
+    // so callers must use the frame accessors rather than getBuffer()'s pointers.
+    bool hasDirectBuffer() const { return activeStream == nullptr && activeCompact == nullptr; }
+
+    // Raw interleaved stereo frames of the active sample, for the audio thread to
+    // resolve once per block. Null when the sample has no interleaved copy.
+    struct FrameView
+    {
+        const float* data = nullptr;
+        int numFrames = 0;
+    };
+
+    // Audio-thread only.
+    FrameView getFrameView() const
+    {
+        return activeFrames != nullptr ? FrameView { activeFrames->getData(), activeFrames->getNumFrames() }
+                                       : FrameView {};
+    }
+
     // Thread-safe snapshot for UI access.
     SnapshotPtr getSnapshot() const;
 
@@ -77,12 +230,21 @@ public:
     float getSampleAtFrame (int frame, int channel) const;
     static float interpolateCubic (float y0, float y1, float y2, float y3, float frac);
 
+    // Nearest zero crossing of the mono mix within searchRange frames of pos,
+    // in any storage: a binary search of zeroCrossings, or a scan without one.
+    // The member form reads the active sample (audio thread only).
+    static int findNearestZeroCrossing (const DecodedSample& sample, int pos, int searchRange = 512);
+    int findNearestZeroCrossing (int pos) const;
+
     int getNumFrames() const { return numFrames.load (std::memory_order_acquire); }
     bool isLoaded() const { return loaded.load (std::memory_order_acquire); }
     double getDecodedSampleRate() const { return decodedSampleRate.load (std::memory_order_acquire); }
     int getSourceNumFrames() const { return sourceNumFrames.load (std::memory_order_acquire); }
     double getSourceSampleRate() const { return sourceSampleRate.load (std::memory_order_acquire); }
     int getNumSessionSamples() const;
+
+    // Audio-thread only — generation of the active decoded sample (0 when empty).
+    uint32_t getActiveGeneration() const { return activeDecoded != nullptr ? activeDecoded->generation : 0; }
     const SessionSample* findSessionSampleById (int sampleId) const;
 
     // Audio-thread only — returns the buffer from the active decoded sample.
@@ -97,6 +259,9 @@ private:
     // Audio-thread-only strong reference to the current sample.
     // Written only on the audio thread (in applyDecodedSample / clear).
     std::shared_ptr<const DecodedSample> activeDecoded;
+    const SampleStream* activeStream = nullptr;   // audio thread; set only with a streamer
+    const CompactPcm* activeCompact = nullptr;    // audio thread
+    const InterleavedFrames* activeFrames = nullptr;   // audio thread
 
     // Atomic snapshot for thread-safe UI access (same object as activeDecoded).
 #if INTERSECT_HAS_STD_ATOMIC_SHARED_PTR
@@ -112,4 +277,10 @@ private:
     std::atomic<int> sourceNumFrames { 0 };
     std::atomic<double> sourceSampleRate { 0.0 };
 
+    uint32_t lastGeneration = 0;  // audio-thread only
+    DeferredReclaimer* reclaimer = nullptr;
+    const SampleStreamer* streamer = nullptr;
+
+    void retireReplaced (SnapshotPtr replaced);
+
 };
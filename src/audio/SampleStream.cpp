@@ -0,0 +1,47 @@
+#include "SampleStream.h"
+
+std::shared_ptr<SampleStream> SampleStream::create (const juce::File& directory, int numFrames)
+{
+    if (numFrames <= 0 || directory.createDirectory().failed())
+        return nullptr;
+
+    std::shared_ptr<SampleStream> stream (new SampleStream());
+    stream->file = directory.getNonexistentChildFile ("session", ".f32", false);
+    stream->numFrames = numFrames;
+    stream->numChunks = (numFrames + kChunkMask) >> kChunkShift;
+
+    const auto numBytes = (juce::int64) numFrames * 2 * (juce::int64) sizeof (float);
+    {
+        juce::FileOutputStream out (stream->file);
+        if (out.failedToOpen()
+            || ! out.setPosition (numBytes - 1)
+            || ! out.writeByte (0))
+            return nullptr;
+
+        out.flush();
+        if (out.getStatus().failed())
+            return nullptr;
+    }
+
+    stream->mapping = std::make_unique<juce::MemoryMappedFile> (stream->file, juce::MemoryMappedFile::readWrite);
+    if (stream->mapping->getData() == nullptr || (juce::int64) stream->mapping->getSize() < numBytes)
+        return nullptr;
+
+    stream->chunkSlots = std::make_unique<std::atomic<int>[]> ((size_t) stream->numChunks);
+    for (int c = 0; c < stream->numChunks; ++c)
+        stream->chunkSlots[(size_t) c].store (-1, std::memory_order_relaxed);
+
+    return stream;
+}
+
+SampleStream::~SampleStream()
+{
+    mapping.reset();
+    file.deleteFile();
+}
+
+float* SampleStream::getChannel (int channel) const
+{
+    auto* data = static_cast<float*> (mapping->getData());
+    return data + (size_t) juce::jlimit (0, 1, channel) * (size_t) numFrames;
+}
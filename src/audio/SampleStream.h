@@ -0,0 +1,40 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+
+// Disk-backed storage for a streamed session. The decoded stereo audio lives in
+// a memory-mapped spill file (planar float, all of left then all of right), so
+// a very long session costs address space and page cache rather than RAM.
+// Worker and UI threads read the mapping directly. The audio thread reads only
+// chunks that SampleStreamer has copied into its pool, found via slotForChunk.
+class SampleStream
+{
+public:
+    static constexpr int kChunkShift = 13;
+    static constexpr int kChunkFrames = 1 << kChunkShift;
+    static constexpr int kChunkMask = kChunkFrames - 1;
+
+    // Creates and maps a spill file for numFrames stereo frames in directory.
+    // Returns nullptr if the file cannot be created or mapped.
+    static std::shared_ptr<SampleStream> create (const juce::File& directory, int numFrames);
+
+    ~SampleStream();
+
+    int getNumFrames() const { return numFrames; }
+    int getNumChunks() const { return numChunks; }
+    float* getChannel (int channel) const;
+
+    // Streamer pool slot holding each chunk, or -1. Written by the streamer
+    // thread, read by the audio thread.
+    std::atomic<int>& slotForChunk (int chunk) const { return chunkSlots[(size_t) chunk]; }
+
+private:
+    SampleStream() = default;
+
+    juce::File file;
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    int numFrames = 0;
+    int numChunks = 0;
+    std::unique_ptr<std::atomic<int>[]> chunkSlots;
+};
@@ -0,0 +1,292 @@
+#include "SampleStreamer.h"
+#include <algorithm>
+
+SampleStreamer::SampleStreamer (const SampleData& s)
+    : juce::Thread ("SampleStreamer"),
+      session (s)
+{
+}
+
+SampleStreamer::~SampleStreamer()
+{
+    stopThread (4000);
+}
+
+void SampleStreamer::setStreamedLoadPending (bool pending)
+{
+    const juce::ScopedLock sl (runLock);
+    streamedLoadPending = pending;
+    if (! pending || running)
+        return;
+
+    waitForThreadToExit (-1);   // a previous run may still be unwinding
+    running = true;
+    startThread (juce::Thread::Priority::high);
+}
+
+void SampleStreamer::setVoiceHint (int voice, const VoiceHint& hint)
+{
+    auto& h = hints[(size_t) voice];
+    h.position.store (hint.position, std::memory_order_relaxed);
+    h.direction.store (hint.direction, std::memory_order_relaxed);
+    h.loopStart.store (hint.loopStart, std::memory_order_relaxed);
+    h.loopEnd.store (hint.loopEnd, std::memory_order_relaxed);
+    h.looping.store (hint.looping, std::memory_order_relaxed);
+    h.pingPong.store (hint.pingPong, std::memory_order_relaxed);
+    h.active.store (true, std::memory_order_release);
+}
+
+void SampleStreamer::clearVoiceHint (int voice)
+{
+    hints[(size_t) voice].active.store (false, std::memory_order_relaxed);
+}
+
+void SampleStreamer::setHeadStarts (const int* starts, int numStarts)
+{
+    numStarts = juce::jlimit (0, kMaxHeads, numStarts);
+    headStartsVersion.fetch_add (1, std::memory_order_acq_rel);
+    for (int i = 0; i < numStarts; ++i)
+        headStarts[(size_t) i].store (starts[i], std::memory_order_relaxed);
+    numHeadStarts.store (numStarts, std::memory_order_relaxed);
+    headStartsVersion.fetch_add (1, std::memory_order_release);
+}
+
+void SampleStreamer::endBlock()
+{
+    if (blockUnderrunReads > 0)
+    {
+        underrunBlocks.fetch_add (1, std::memory_order_relaxed);
+        underrunReads.fetch_add (blockUnderrunReads, std::memory_order_relaxed);
+        blockUnderrunReads = 0;
+    }
+
+    // Sequentially consistent with releaseSlot(): every read of a slot that was
+    // dropped before this count is taken finishes before it goes up.
+    blocksCompleted.fetch_add (1);
+}
+
+void SampleStreamer::run()
+{
+    while (! threadShouldExit())
+    {
+        refresh();
+
+        const bool streamed = current != nullptr && current->stream != nullptr;
+        {
+            const juce::ScopedLock sl (runLock);
+            if (streamed)
+            {
+                streamedLoadPending = false;
+            }
+            else if (! streamedLoadPending && quarantined.empty())
+            {
+                // Every dropped slot has outlived the blocks that could read it.
+                running = false;
+                pool.reset();
+                slotChunks.clear();
+                freeSlots.clear();
+                break;
+            }
+        }
+
+        wait (streamed ? 3 : 50);
+    }
+
+    releaseAll();
+    current.reset();
+}
+
+void SampleStreamer::refresh()
+{
+    auto snap = session.getSnapshot();
+    if (snap != current)
+    {
+        releaseAll();
+        current = std::move (snap);
+        pass = 0;
+        wantedPass.assign (current != nullptr && current->stream != nullptr
+                               ? (size_t) current->stream->getNumChunks() : 0, 0);
+    }
+
+    reclaimQuarantined();
+
+    if (current == nullptr || current->stream == nullptr)
+        return;
+
+    if (pool == nullptr)
+    {
+        pool = std::make_unique<float[]> ((size_t) kPoolChunks * 2 * SampleStream::kChunkFrames);
+        slotChunks.assign ((size_t) kPoolChunks, -1);
+        freeSlots.clear();
+        for (int slot = kPoolChunks - 1; slot >= 0; --slot)
+            freeSlots.push_back (slot);
+    }
+
+    const auto& stream = *current->stream;
+    collectWanted (stream, *current);
+
+    // Drop resident chunks nothing wants any more, then fill in priority order.
+    for (int slot = 0; slot < kPoolChunks; ++slot)
+    {
+        const int chunk = slotChunks[(size_t) slot];
+        if (chunk >= 0 && wantedPass[(size_t) chunk] != pass)
+            releaseSlot (slot);
+    }
+
+    for (const int chunk : wanted)
+    {
+        if (threadShouldExit() || freeSlots.empty())
+            break;
+        if (stream.slotForChunk (chunk).load (std::memory_order_relaxed) >= 0)
+            continue;
+
+        const int slot = freeSlots.back();
+        freeSlots.pop_back();
+        fillSlot (slot, stream, chunk);
+        slotChunks[(size_t) slot] = chunk;
+        stream.slotForChunk (chunk).store (slot, std::memory_order_release);
+    }
+}
+
+void SampleStreamer::releaseAll()
+{
+    for (int slot = 0; slot < (int) slotChunks.size(); ++slot)
+        if (slotChunks[(size_t) slot] >= 0)
+            releaseSlot (slot);
+}
+
+void SampleStreamer::releaseSlot (int slot)
+{
+    const int chunk = slotChunks[(size_t) slot];
+    current->stream->slotForChunk (chunk).store (-1);
+    slotChunks[(size_t) slot] = -1;
+    quarantined.push_back ({ slot, blocksCompleted.load() });
+}
+
+void SampleStreamer::reclaimQuarantined()
+{
+    const auto completed = blocksCompleted.load (std::memory_order_acquire);
+    auto reusable = std::partition (quarantined.begin(), quarantined.end(),
+                                    [completed] (const QuarantinedSlot& q) { return completed <= q.epoch; });
+    for (auto it = reusable; it != quarantined.end(); ++it)
+        freeSlots.push_back (it->slot);
+    quarantined.erase (reusable, quarantined.end());
+}
+
+void SampleStreamer::want (int chunk, int numChunks)
+{
+    if (chunk < 0 || chunk >= numChunks || wantedPass[(size_t) chunk] == pass)
+        return;
+
+    wantedPass[(size_t) chunk] = pass;
+    wanted.push_back (chunk);
+}
+
+void SampleStreamer::collectWanted (const SampleStream& stream, const SampleData::DecodedSample& sample)
+{
+    if (++pass == 0)
+    {
+        std::fill (wantedPass.begin(), wantedPass.end(), 0u);
+        pass = 1;
+    }
+    wanted.clear();
+
+    const int numFrames = stream.getNumFrames();
+    const int numChunks = stream.getNumChunks();
+    constexpr int kShift = SampleStream::kChunkShift;
+    constexpr int kPathLength = kReadAheadChunks + 2;
+
+    // Each active voice's path: the chunk behind (interpolation taps and grain
+    // look-back), then read-ahead chunks, wrapping or turning at loop bounds.
+    std::array<std::array<int, kPathLength + 2>, kMaxVoices> paths;
+    std::array<int, kMaxVoices> pathLengths {};
+
+    for (int v = 0; v < kMaxVoices; ++v)
+    {
+        const auto& h = hints[(size_t) v];
+        if (! h.active.load (std::memory_order_acquire))
+            continue;
+
+        int frame = h.position.load (std::memory_order_relaxed);
+        int dir = h.direction.load (std::memory_order_relaxed) >= 0 ? 1 : -1;
+        const int loopStart = h.loopStart.load (std::memory_order_relaxed);
+        const int loopEnd = h.loopEnd.load (std::memory_order_relaxed);
+        const bool pingPong = h.pingPong.load (std::memory_order_relaxed);
+        const bool bounded = (pingPong || h.looping.load (std::memory_order_relaxed)) && loopEnd > loopStart;
+
+        auto& path = paths[(size_t) v];
+        int& n = pathLengths[(size_t) v];
+        path[(size_t) n++] = (frame - dir * SampleStream::kChunkFrames) >> kShift;
+
+        for (int i = 0; i <= kReadAheadChunks; ++i)
+        {
+            path[(size_t) n++] = juce::jlimit (0, numFrames - 1, frame) >> kShift;
+            frame += dir * SampleStream::kChunkFrames;
+
+            if (bounded && dir > 0 && frame >= loopEnd)
+            {
+                const int over = (frame - loopEnd) % (loopEnd - loopStart);
+                frame = pingPong ? loopEnd - 1 - over : loopStart + over;
+                dir = pingPong ? -1 : 1;
+            }
+            else if (bounded && dir < 0 && frame < loopStart)
+            {
+                const int over = (loopStart - frame - 1) % (loopEnd - loopStart);
+                frame = pingPong ? loopStart + over : loopEnd - 1 - over;
+                dir = pingPong ? 1 : -1;
+            }
+        }
+
+        // Loop crossfades read across both ends.
+        if (bounded)
+        {
+            path[(size_t) n++] = loopStart >> kShift;
+            path[(size_t) n++] = (loopEnd - 1) >> kShift;
+        }
+    }
+
+    // Nearest chunks of every voice first, so no voice starves another.
+    for (int i = 0; i < kPathLength + 2; ++i)
+        for (int v = 0; v < kMaxVoices; ++v)
+            if (i < pathLengths[(size_t) v])
+                want (paths[(size_t) v][(size_t) i], numChunks);
+
+    // Heads for slice starts (when a consistent copy can be read) and session samples.
+    const auto version = headStartsVersion.load (std::memory_order_acquire);
+    if ((version & 1u) == 0)
+    {
+        const int count = numHeadStarts.load (std::memory_order_relaxed);
+        std::vector<int> starts ((size_t) count);
+        for (int i = 0; i < count; ++i)
+            starts[(size_t) i] = headStarts[(size_t) i].load (std::memory_order_relaxed);
+
+        std::atomic_thread_fence (std::memory_order_acquire);
+        if (headStartsVersion.load (std::memory_order_relaxed) == version)
+            headCopy = std::move (starts);
+    }
+
+    const auto wantHead = [&] (int start)
+    {
+        for (int f = start; f < start + kHeadFrames; f += SampleStream::kChunkFrames)
+            want (juce::jlimit (0, numFrames - 1, f) >> kShift, numChunks);
+        want ((start + kHeadFrames - 1) >> kShift, numChunks);
+    };
+
+    for (const int start : headCopy)
+        wantHead (start);
+    for (const auto& s : sample.sessionSamples)
+        wantHead (s.startFrame);
+}
+
+void SampleStreamer::fillSlot (int slot, const SampleStream& stream, int chunk)
+{
+    const int first = chunk << SampleStream::kChunkShift;
+    const int count = juce::jmin (SampleStream::kChunkFrames, stream.getNumFrames() - first);
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        float* dest = pool.get() + ((size_t) slot * 2 + (size_t) ch) * SampleStream::kChunkFrames;
+        std::copy_n (stream.getChannel (ch) + first, count, dest);
+        std::fill (dest + count, dest + SampleStream::kChunkFrames, 0.0f);
+    }
+}
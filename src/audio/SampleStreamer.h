@@ -0,0 +1,140 @@
+#pragma once
+#include "SampleData.h"
+#include "SampleStream.h"
+#include "SliceManager.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Feeds the audio thread from streamed (disk-backed) sessions. A fixed pool of
+// chunk slots holds heads for every slice and session-sample start, plus a
+// read-ahead window along each active voice's path that follows loops and
+// ping-pong turns. A background thread copies chunks in from the spill mapping
+// and publishes each one through the stream's slot table. A dropped chunk's
+// slot is reused only once the audio thread has finished the block that might
+// still be reading it, so audio reads never lock and never see a slot rewritten.
+// The thread only runs while a streamed session is playing or about to be.
+class SampleStreamer : private juce::Thread
+{
+public:
+    static constexpr int kPoolChunks = 1024;   // 64 MB of stereo float
+    static constexpr int kHeadFrames = 2 * SampleStream::kChunkFrames;
+    static constexpr int kReadAheadChunks = 8;
+    static constexpr int kMaxHeads = SliceManager::kMaxSlices;
+    static constexpr int kMaxVoices = 32;      // VoicePool::kMaxVoices
+
+    struct VoiceHint
+    {
+        int position = 0;
+        int direction = 1;
+        int loopStart = 0;
+        int loopEnd = 0;
+        bool looping = false;
+        bool pingPong = false;
+    };
+
+    // Marks the end of a processBlock for slot reuse; hold one for the whole block.
+    struct BlockScope
+    {
+        explicit BlockScope (SampleStreamer& s) : streamer (s) {}
+        ~BlockScope() { streamer.endBlock(); }
+        SampleStreamer& streamer;
+    };
+
+    explicit SampleStreamer (const SampleData& session);
+    ~SampleStreamer() override;
+
+    // Any thread, before a finished load is handed to the audio thread. A
+    // streamed load starts the thread; once no streamed session is playing or
+    // pending it frees its chunk pool and stops.
+    void setStreamedLoadPending (bool pending);
+
+    // Audio thread. Frames whose chunk is not resident yet read as silence and
+    // count as an underrun.
+    float readFrame (const SampleStream& stream, int frame, int channel) const
+    {
+        const int slot = stream.slotForChunk (frame >> SampleStream::kChunkShift).load();
+        if (slot < 0)
+        {
+            ++blockUnderrunReads;
+            return 0.0f;
+        }
+
+        const size_t offset = ((size_t) slot * 2 + (size_t) channel) * SampleStream::kChunkFrames;
+        return pool[offset + (size_t) (frame & SampleStream::kChunkMask)];
+    }
+
+    // Audio thread: where each voice is reading, published once per block.
+    void setVoiceHint (int voice, const VoiceHint& hint);
+    void clearVoiceHint (int voice);
+
+    // Audio thread: slice start frames to keep heads resident for.
+    void setHeadStarts (const int* starts, int numStarts);
+
+    // Blocks in which some read found its chunk not streamed in yet, and the
+    // total reads that returned silence because of it.
+    uint64_t getNumUnderrunBlocks() const { return underrunBlocks.load (std::memory_order_acquire); }
+    uint64_t getNumUnderrunReads() const  { return underrunReads.load (std::memory_order_acquire); }
+
+private:
+    struct HintSlot
+    {
+        std::atomic<bool> active { false };
+        std::atomic<int> position { 0 };
+        std::atomic<int> direction { 1 };
+        std::atomic<int> loopStart { 0 };
+        std::atomic<int> loopEnd { 0 };
+        std::atomic<bool> looping { false };
+        std::atomic<bool> pingPong { false };
+    };
+
+    struct QuarantinedSlot
+    {
+        int slot = -1;
+        uint64_t epoch = 0;   // reusable once blocksCompleted passes this
+    };
+
+    void run() override;
+    void endBlock();
+
+    // Streamer thread only.
+    void refresh();
+    void releaseAll();
+    void releaseSlot (int slot);
+    void reclaimQuarantined();
+    void collectWanted (const SampleStream& stream, const SampleData::DecodedSample& sample);
+    void want (int chunk, int numChunks);
+    void fillSlot (int slot, const SampleStream& stream, int chunk);
+
+    const SampleData& session;
+
+    juce::CriticalSection runLock;
+    bool running = false;               // guarded by runLock
+    bool streamedLoadPending = false;   // guarded by runLock
+
+    // Pool data, written by the streamer thread only into free slots.
+    std::unique_ptr<float[]> pool;
+
+    std::array<HintSlot, kMaxVoices> hints;
+    std::array<std::atomic<int>, kMaxHeads> headStarts {};
+    std::atomic<int> numHeadStarts { 0 };
+    std::atomic<uint32_t> headStartsVersion { 0 };   // odd while being written
+
+    mutable uint64_t blockUnderrunReads = 0;   // audio thread
+    std::atomic<uint64_t> blocksCompleted { 0 };
+    std::atomic<uint64_t> underrunBlocks { 0 };
+    std::atomic<uint64_t> underrunReads { 0 };
+
+    // Streamer thread state.
+    SampleData::SnapshotPtr current;
+    std::vector<int> slotChunks;      // chunk held by each slot, or -1
+    std::vector<int> freeSlots;
+    std::vector<QuarantinedSlot> quarantined;
+    std::vector<int> headCopy;
+    std::vector<int> wanted;          // chunks in priority order
+    std::vector<uint32_t> wantedPass; // per chunk: pass that last wanted it
+    uint32_t pass = 0;
+};
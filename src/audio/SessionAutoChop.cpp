@@ -0,0 +1,169 @@
+#include "SessionAutoChop.h"
+#include "AudioAnalysis.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+namespace
+{
+// Work shared between the chopping thread and its pool helpers. Session
+// samples are claimed by index and each lands in its own slot, so boundaries
+// stay in session order. Helpers hold a reference, so ones that start after
+// the caller has returned just find nothing to do.
+struct ChopJob
+{
+    const SampleData::DecodedSample* session = nullptr;
+    SessionAutoChop::Settings settings;
+    const SessionOdfCache* odfCache = nullptr;
+    std::function<bool()> shouldCancel;
+    int numSamples = 0;
+
+    std::vector<std::vector<int>> onsets;
+    std::atomic<int> nextIndex { 0 };
+    std::atomic<int> numFinished { 0 };
+    std::atomic<bool> cancelled { false };
+    juce::WaitableEvent allFinished;
+
+    void work()
+    {
+        for (;;)
+        {
+            const int i = nextIndex.fetch_add (1, std::memory_order_relaxed);
+            if (i >= numSamples)
+                return;
+
+            if (! cancelled.load (std::memory_order_relaxed) && ! (shouldCancel && shouldCancel()))
+                onsets[(size_t) i] = analyse (session->sessionSamples[(size_t) i]);
+            else
+                cancelled.store (true, std::memory_order_relaxed);
+
+            if (numFinished.fetch_add (1, std::memory_order_acq_rel) + 1 == numSamples)
+                allFinished.signal();
+        }
+    }
+
+    // Onsets of one session sample, in session frames, strictly inside it.
+    std::vector<int> analyse (const SampleData::SessionSample& s) const
+    {
+        if (s.numFrames <= 0)
+            return {};
+
+        const int first = s.startFrame;
+        const int last = s.startFrame + s.numFrames;
+        const double sampleRate = session->decodedSampleRate > 0.0 ? session->decodedSampleRate : 44100.0;
+        const auto audio = session->copyFrames (first, s.numFrames);
+
+        AudioAnalysis::ODFResult odf;
+        if (odfCache != nullptr && odfCache->find (*session, first, last, odf))
+        {
+            odf.start -= first;
+            odf.end -= first;
+            odf.frameStart -= first;
+        }
+        else
+        {
+            odf = AudioAnalysis::computeSpectralFluxODF (audio, 0, s.numFrames, sampleRate);
+        }
+
+        auto positions = AudioAnalysis::pickTransientsFromODF (odf, audio, settings.sensitivity,
+                                                               sampleRate, settings.minSliceLenMs);
+        for (auto& p : positions)
+            p += first;
+
+        if (settings.snapToZeroCrossing)
+        {
+            for (auto& p : positions)
+                p = juce::jlimit (first + 1, last - 1, SampleData::findNearestZeroCrossing (*session, p));
+
+            std::sort (positions.begin(), positions.end());
+            const int minDist = (int) std::round (sampleRate * (double) settings.minSliceLenMs / 1000.0);
+            std::vector<int> sanitized;
+            int lastPos = first - minDist;
+            for (int p : positions)
+            {
+                if (p - lastPos >= minDist)
+                {
+                    sanitized.push_back (p);
+                    lastPos = p;
+                }
+            }
+            positions = std::move (sanitized);
+        }
+
+        positions.erase (std::remove_if (positions.begin(), positions.end(),
+                                         [first, last] (int p) { return p <= first || p >= last; }),
+                         positions.end());
+        return positions;
+    }
+};
+
+// Picks keep evenly spaced entries of sorted, starting with the first.
+std::vector<int> thinEvenly (const std::vector<int>& sorted, int keep)
+{
+    if (keep >= (int) sorted.size())
+        return sorted;
+
+    std::vector<int> kept;
+    for (int k = 0; k < keep; ++k)
+        kept.push_back (sorted[(size_t) ((juce::int64) k * (juce::int64) sorted.size() / keep)]);
+    return kept;
+}
+} // namespace
+
+namespace SessionAutoChop
+{
+
+std::vector<int> findBoundaries (const SampleData::DecodedSample& session,
+                                 const Settings& settings,
+                                 const SessionOdfCache* odfCache,
+                                 juce::ThreadPool* pool,
+                                 const std::function<bool()>& shouldCancel)
+{
+    const int numSamples = (int) session.sessionSamples.size();
+    if (numSamples == 0)
+        return {};
+
+    auto job = std::make_shared<ChopJob>();
+    job->session = &session;
+    job->settings = settings;
+    job->odfCache = odfCache;
+    job->shouldCancel = shouldCancel;
+    job->numSamples = numSamples;
+    job->onsets.resize ((size_t) numSamples);
+
+    const int numHelpers = pool != nullptr ? juce::jmin (pool->getNumThreads(), numSamples - 1) : 0;
+    for (int h = 0; h < numHelpers; ++h)
+        pool->addJob ([job] { job->work(); });
+
+    job->work();
+    job->allFinished.wait (-1);
+    if (job->cancelled.load (std::memory_order_acquire))
+        return {};
+
+    // Sample starts come first; onsets share what is left of the slice budget.
+    const int maxBoundaries = juce::jmax (0, settings.maxSlices - 1);
+    const int numStarts = juce::jmin (numSamples - 1, maxBoundaries);
+    const int onsetBudget = maxBoundaries - numStarts;
+
+    juce::int64 totalOnsets = 0;
+    for (const auto& o : job->onsets)
+        totalOnsets += (juce::int64) o.size();
+
+    std::vector<int> boundaries;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (i > 0 && i <= numStarts)
+            boundaries.push_back (session.sessionSamples[(size_t) i].startFrame);
+
+        const auto& onsets = job->onsets[(size_t) i];
+        const auto kept = totalOnsets > onsetBudget
+                              ? thinEvenly (onsets, (int) ((juce::int64) onsets.size() * onsetBudget / totalOnsets))
+                              : onsets;
+        boundaries.insert (boundaries.end(), kept.begin(), kept.end());
+    }
+
+    return boundaries;
+}
+
+} // namespace SessionAutoChop
@@ -0,0 +1,32 @@
+#pragma once
+#include "SampleData.h"
+#include "SessionOdfCache.h"
+#include <juce_core/juce_core.h>
+#include <functional>
+#include <vector>
+
+// Transient detection over a whole session at once, for chopping every
+// session sample in one step instead of one AutoChop pass per slice.
+namespace SessionAutoChop
+{
+
+struct Settings
+{
+    float sensitivity = 5.0f;        // as passed to pickTransientsFromODF
+    float minSliceLenMs = 100.0f;
+    bool snapToZeroCrossing = false;
+    int maxSlices = 128;
+};
+
+// Interior slice boundaries for the whole session, ascending: every session
+// sample's start after the first, plus its onsets. Samples are analysed in
+// parallel on pool's threads and the caller's; ODFs come from odfCache where
+// it has them. When the onsets would make more than maxSlices slices, each
+// sample keeps an evenly spaced share of its own. Empty if cancelled.
+std::vector<int> findBoundaries (const SampleData::DecodedSample& session,
+                                 const Settings& settings,
+                                 const SessionOdfCache* odfCache,
+                                 juce::ThreadPool* pool,
+                                 const std::function<bool()>& shouldCancel = {});
+
+} // namespace SessionAutoChop
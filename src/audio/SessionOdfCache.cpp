@@ -0,0 +1,129 @@
+#include "SessionOdfCache.h"
+#include <algorithm>
+
+SessionOdfCache::SessionOdfCache (const SampleData& s, juce::ThreadPool& helpers)
+    : juce::Thread ("ODF-Cache"),
+      session (s),
+      pool (helpers)
+{
+    startThread (juce::Thread::Priority::background);
+}
+
+SessionOdfCache::~SessionOdfCache()
+{
+    stopThread (4000);
+}
+
+void SessionOdfCache::run()
+{
+    while (! threadShouldExit())
+    {
+        refresh();
+        wait (100);
+    }
+}
+
+SessionOdfCache::EntryPtr SessionOdfCache::findEntry (const SampleData::SessionSample& s, double rate) const
+{
+    const juce::ScopedLock sl (lock);
+    for (const auto& entry : entries)
+        if (entry->matches (s, rate))
+            return entry;
+    return nullptr;
+}
+
+void SessionOdfCache::refresh()
+{
+    auto snap = session.getSnapshot();
+    if (snap == nullptr || snap->generation == analysedGeneration || snap->partial)
+        return;
+
+    const double rate = snap->decodedSampleRate;
+    std::vector<EntryPtr> kept;
+
+    for (const auto& s : snap->sessionSamples)
+    {
+        if (threadShouldExit())
+            return;
+
+        // A newer session supersedes this one; start over on it.
+        if (session.getSnapshot() != snap)
+            return;
+
+        auto entry = findEntry (s, rate);
+        if (entry == nullptr && s.numFrames > 0)
+        {
+            const auto audio = snap->copyFrames (s.startFrame, s.numFrames);
+            auto fresh = std::make_shared<Entry>();
+            fresh->sampleId = s.sampleId;
+            fresh->filePath = s.filePath;
+            fresh->numFrames = s.numFrames;
+            fresh->sampleRate = rate;
+            fresh->odf = AudioAnalysis::computeSpectralFluxODF (audio, 0, audio.getNumSamples(), rate, &pool).odf;
+            entry = std::move (fresh);
+
+            const juce::ScopedLock sl (lock);
+            entries.push_back (entry);
+        }
+
+        if (entry != nullptr)
+            kept.push_back (std::move (entry));
+    }
+
+    // Drop samples no longer in the session.
+    {
+        const juce::ScopedLock sl (lock);
+        entries = std::move (kept);
+    }
+    analysedGeneration = snap->generation;
+}
+
+bool SessionOdfCache::find (const SampleData::DecodedSample& snapshot, int start, int end,
+                            AudioAnalysis::ODFResult& result) const
+{
+    const auto& samples = snapshot.sessionSamples;
+    const auto it = std::find_if (samples.begin(), samples.end(), [start] (const SampleData::SessionSample& s)
+    {
+        return start >= s.startFrame && start < s.startFrame + s.numFrames;
+    });
+
+    if (it == samples.end() || end <= start || end > it->startFrame + it->numFrames)
+        return false;
+
+    const auto entry = findEntry (*it, snapshot.decodedSampleRate);
+    if (entry == nullptr)
+        return false;
+
+    constexpr int hop = AudioAnalysis::kOdfHopSize;
+    constexpr int fftSize = AudioAnalysis::kOdfFftSize;
+
+    const int firstFrame = (start - it->startFrame + hop - 1) / hop;
+    const int frameStart = it->startFrame + firstFrame * hop;
+
+    result = {};
+    result.start = start;
+    result.end = end;
+    result.frameStart = frameStart;
+    result.hopSize = hop;
+    result.fftSize = fftSize;
+
+    if (end - frameStart < fftSize)
+        return true;
+
+    const int numFrames = juce::jmin ((end - frameStart - fftSize) / hop + 1,
+                                      (int) entry->odf.size() - firstFrame);
+    if (numFrames <= 0)
+        return true;
+
+    result.odf.assign (entry->odf.begin() + firstFrame, entry->odf.begin() + firstFrame + numFrames);
+
+    // The cached first frame was differenced against the frame before it.
+    if (firstFrame > 0)
+    {
+        const auto edge = snapshot.copyFrames (frameStart, fftSize);
+        const auto edgeOdf = AudioAnalysis::computeSpectralFluxODF (edge, 0, fftSize);
+        if (! edgeOdf.odf.empty())
+            result.odf.front() = edgeOdf.odf.front();
+    }
+    return true;
+}
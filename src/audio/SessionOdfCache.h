@@ -0,0 +1,56 @@
+#pragma once
+#include "AudioAnalysis.h"
+#include "SampleData.h"
+#include <juce_core/juce_core.h>
+#include <memory>
+#include <vector>
+
+// Spectral flux ODFs for every sample of the current session, computed in the
+// background whenever the session changes. Each session sample is analysed on
+// its own hop grid from its first frame and kept by identity, so samples that
+// survive an append or a delete are not analysed again.
+// Range queries slice the cached frames; only the first frame is recomputed,
+// because its flux must be taken against silence rather than the frame before.
+class SessionOdfCache : private juce::Thread
+{
+public:
+    SessionOdfCache (const SampleData& session, juce::ThreadPool& helpers);
+    ~SessionOdfCache() override;
+
+    // Any thread. The ODF of [start, end) of snapshot on the hop grid of the
+    // session sample holding start (frames begin up to one hop after start; see
+    // ODFResult::frameStart). False if that sample is not analysed yet, or the
+    // range runs past its end.
+    bool find (const SampleData::DecodedSample& snapshot, int start, int end,
+               AudioAnalysis::ODFResult& result) const;
+
+private:
+    struct Entry
+    {
+        int sampleId = -1;
+        juce::String filePath;
+        int numFrames = 0;
+        double sampleRate = 0.0;
+        std::vector<float> odf;   // frame k starts k hops into the sample
+
+        bool matches (const SampleData::SessionSample& s, double rate) const
+        {
+            return sampleId == s.sampleId && numFrames == s.numFrames
+                && sampleRate == rate && filePath == s.filePath;
+        }
+    };
+
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    void run() override;
+    void refresh();
+    EntryPtr findEntry (const SampleData::SessionSample& s, double rate) const;
+
+    const SampleData& session;
+    juce::ThreadPool& pool;
+
+    mutable juce::CriticalSection lock;
+    std::vector<EntryPtr> entries;   // guarded by lock; written by the worker only
+
+    uint32_t analysedGeneration = 0;   // worker thread: last session fully analysed
+};
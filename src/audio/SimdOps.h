@@ -0,0 +1,351 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Compile-time SIMD target detection for the hand-vectorised audio kernels.
+// Each target is built separately (e.g. macOS universal), so these are per-arch.
+#if defined (__AVX__)
+ #define INTERSECT_SIMD_AVX 1
+#endif
+
+#if defined (__SSE2__) || defined (_M_X64) || defined (_M_AMD64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define INTERSECT_SIMD_SSE 1
+ #include <immintrin.h>
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+ #define INTERSECT_SIMD_NEON 1
+ #include <arm_neon.h>
+#endif
+
+namespace SimdOps
+{
+
+// Dot product of two float arrays; n must be a multiple of 4. No alignment required.
+inline float dot (const float* a, const float* b, int n) noexcept
+{
+#if INTERSECT_SIMD_SSE
+    __m128 acc = _mm_setzero_ps();
+    for (int i = 0; i < n; i += 4)
+        acc = _mm_add_ps (acc, _mm_mul_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+
+    __m128 hi = _mm_movehl_ps (acc, acc);
+    acc = _mm_add_ps (acc, hi);
+    hi = _mm_shuffle_ps (acc, acc, 0x55);
+    acc = _mm_add_ss (acc, hi);
+    return _mm_cvtss_f32 (acc);
+#elif INTERSECT_SIMD_NEON
+    float32x4_t acc = vdupq_n_f32 (0.0f);
+    for (int i = 0; i < n; i += 4)
+        acc = vmlaq_f32 (acc, vld1q_f32 (a + i), vld1q_f32 (b + i));
+
+    const float32x2_t sum = vadd_f32 (vget_low_f32 (acc), vget_high_f32 (acc));
+    return vget_lane_f32 (vpadd_f32 (sum, sum), 0);
+#else
+    float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < n; i += 4)
+        for (int k = 0; k < 4; ++k)
+            acc[k] += a[i + k] * b[i + k];
+
+    return (acc[0] + acc[2]) + (acc[1] + acc[3]);
+#endif
+}
+
+// IEEE half-precision bits to float, including subnormals, infinities and NaN.
+inline float halfToFloat (uint16_t h) noexcept
+{
+    const uint32_t sign = (uint32_t) (h & 0x8000u) << 16;
+    uint32_t exponent = (h >> 10) & 0x1fu;
+    uint32_t mantissa = h & 0x3ffu;
+    uint32_t bits;
+
+    if (exponent == 0)
+    {
+        if (mantissa == 0)
+        {
+            bits = sign;
+        }
+        else
+        {
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400u) == 0)
+            {
+                mantissa <<= 1;
+                --exponent;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+        }
+    }
+    else if (exponent == 31)
+    {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+
+    float f;
+    std::memcpy (&f, &bits, sizeof (f));
+    return f;
+}
+
+// Float to IEEE half-precision bits, rounding to nearest even.
+inline uint16_t floatToHalf (float f) noexcept
+{
+    uint32_t x;
+    std::memcpy (&x, &f, sizeof (x));
+    const auto sign = (uint16_t) ((x >> 16) & 0x8000u);
+    x &= 0x7fffffffu;
+
+    if (x >= 0x7f800000u)
+        return (uint16_t) (sign | (x > 0x7f800000u ? 0x7e00u : 0x7c00u));
+    if (x >= 0x477ff000u)
+        return (uint16_t) (sign | 0x7c00u);
+
+    if (x < 0x38800000u)
+    {
+        // Below the smallest normal half: round into the subnormal range.
+        if (x < 0x33000000u)
+            return sign;
+
+        const int shift = 126 - (int) (x >> 23);
+        const uint32_t mantissa = (x & 0x7fffffu) | 0x800000u;
+        uint32_t h = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (h & 1u)))
+            ++h;
+        return (uint16_t) (sign | h);
+    }
+
+    uint32_t h = (x >> 13) - ((127u - 15u) << 10);
+    const uint32_t rest = x & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (h & 1u)))
+        ++h;
+    return (uint16_t) (sign | h);
+}
+
+// Converts n int16 samples to float in [-1, 1). No alignment required.
+inline void int16ToFloat (const int16_t* src, float* dest, int n) noexcept
+{
+    constexpr float scale = 1.0f / 32768.0f;
+    int i = 0;
+#if INTERSECT_SIMD_SSE
+    const __m128 s = _mm_set1_ps (scale);
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m128i x = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i));
+        const __m128i lo = _mm_srai_epi32 (_mm_unpacklo_epi16 (x, x), 16);
+        const __m128i hi = _mm_srai_epi32 (_mm_unpackhi_epi16 (x, x), 16);
+        _mm_storeu_ps (dest + i,     _mm_mul_ps (_mm_cvtepi32_ps (lo), s));
+        _mm_storeu_ps (dest + i + 4, _mm_mul_ps (_mm_cvtepi32_ps (hi), s));
+    }
+#elif INTERSECT_SIMD_NEON
+    for (; i + 8 <= n; i += 8)
+    {
+        const int16x8_t x = vld1q_s16 (src + i);
+        vst1q_f32 (dest + i,     vmulq_n_f32 (vcvtq_f32_s32 (vmovl_s16 (vget_low_s16 (x))), scale));
+        vst1q_f32 (dest + i + 4, vmulq_n_f32 (vcvtq_f32_s32 (vmovl_s16 (vget_high_s16 (x))), scale));
+    }
+#endif
+    for (; i < n; ++i)
+        dest[i] = (float) src[i] * scale;
+}
+
+// Converts n half-precision samples to float. No alignment required.
+inline void halfToFloat (const uint16_t* src, float* dest, int n) noexcept
+{
+    int i = 0;
+#if INTERSECT_SIMD_SSE
+    // Shift exponent and mantissa into place and rebias with one multiply, which
+    // also normalises subnormals; infinities and NaN get their exponent forced.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i noSign = _mm_set1_epi32 (0x7fff);
+    const __m128i maxFinite = _mm_set1_epi32 (0x7bff);
+    const __m128 rebias = _mm_castsi128_ps (_mm_set1_epi32 ((254 - 15) << 23));
+    const __m128i infNanExponent = _mm_set1_epi32 (255 << 23);
+
+    const auto convert4 = [&] (__m128i h)
+    {
+        const __m128i expMantissa = _mm_and_si128 (h, noSign);
+        const __m128i sign = _mm_slli_epi32 (_mm_xor_si128 (h, expMantissa), 16);
+        const __m128 scaled = _mm_mul_ps (_mm_castsi128_ps (_mm_slli_epi32 (expMantissa, 13)), rebias);
+        const __m128i infNan = _mm_and_si128 (_mm_cmpgt_epi32 (expMantissa, maxFinite), infNanExponent);
+        return _mm_or_ps (scaled, _mm_castsi128_ps (_mm_or_si128 (sign, infNan)));
+    };
+
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m128i x = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i));
+        _mm_storeu_ps (dest + i,     convert4 (_mm_unpacklo_epi16 (x, zero)));
+        _mm_storeu_ps (dest + i + 4, convert4 (_mm_unpackhi_epi16 (x, zero)));
+    }
+#elif INTERSECT_SIMD_NEON && (defined (__aarch64__) || defined (_M_ARM64))
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32 (dest + i, vcvt_f32_f16 (vreinterpret_f16_u16 (vld1_u16 (src + i))));
+#endif
+    for (; i < n; ++i)
+        dest[i] = halfToFloat (src[i]);
+}
+
+// Magnitudes of n interleaved complex values (re, im, re, im, ...). No alignment required.
+inline void complexMagnitudes (const float* interleaved, float* mags, int n) noexcept
+{
+    int i = 0;
+#if INTERSECT_SIMD_SSE
+    for (; i + 4 <= n; i += 4)
+    {
+        const __m128 a = _mm_loadu_ps (interleaved + 2 * i);
+        const __m128 b = _mm_loadu_ps (interleaved + 2 * i + 4);
+        const __m128 re = _mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0));
+        const __m128 im = _mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1));
+        _mm_storeu_ps (mags + i, _mm_sqrt_ps (_mm_add_ps (_mm_mul_ps (re, re), _mm_mul_ps (im, im))));
+    }
+#elif INTERSECT_SIMD_NEON && (defined (__aarch64__) || defined (_M_ARM64))
+    for (; i + 4 <= n; i += 4)
+    {
+        const float32x4x2_t z = vld2q_f32 (interleaved + 2 * i);
+        vst1q_f32 (mags + i, vsqrtq_f32 (vmlaq_f32 (vmulq_f32 (z.val[0], z.val[0]), z.val[1], z.val[1])));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        const float re = interleaved[2 * i];
+        const float im = interleaved[2 * i + 1];
+        mags[i] = std::sqrt (re * re + im * im);
+    }
+}
+
+// Sum of the positive parts of (a[i] - b[i]). No alignment required.
+inline float positiveDifferenceSum (const float* a, const float* b, int n) noexcept
+{
+    int i = 0;
+    float sum = 0.0f;
+#if INTERSECT_SIMD_SSE
+    const __m128 zero = _mm_setzero_ps();
+    __m128 acc = zero;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm_add_ps (acc, _mm_max_ps (_mm_sub_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)), zero));
+
+    __m128 hi = _mm_movehl_ps (acc, acc);
+    acc = _mm_add_ps (acc, hi);
+    hi = _mm_shuffle_ps (acc, acc, 0x55);
+    sum = _mm_cvtss_f32 (_mm_add_ss (acc, hi));
+#elif INTERSECT_SIMD_NEON
+    const float32x4_t zero = vdupq_n_f32 (0.0f);
+    float32x4_t acc = zero;
+    for (; i + 4 <= n; i += 4)
+        acc = vaddq_f32 (acc, vmaxq_f32 (vsubq_f32 (vld1q_f32 (a + i), vld1q_f32 (b + i)), zero));
+
+    const float32x2_t pair = vadd_f32 (vget_low_f32 (acc), vget_high_f32 (acc));
+    sum = vget_lane_f32 (vpadd_f32 (pair, pair), 0);
+#endif
+    for (; i < n; ++i)
+        sum += std::max (0.0f, a[i] - b[i]);
+    return sum;
+}
+
+// Bit j set where the mono mix (a[j] + b[j]) * 0.5 is negative, for j in [0, 64).
+inline uint64_t negativeMonoMask64 (const float* a, const float* b) noexcept
+{
+    uint64_t mask = 0;
+#if INTERSECT_SIMD_SSE
+    const __m128 half = _mm_set1_ps (0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    for (int i = 0; i < 64; i += 4)
+    {
+        const __m128 mono = _mm_mul_ps (_mm_add_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)), half);
+        mask |= (uint64_t) _mm_movemask_ps (_mm_cmplt_ps (mono, zero)) << i;
+    }
+#elif INTERSECT_SIMD_NEON && (defined (__aarch64__) || defined (_M_ARM64))
+    static const uint32_t laneBits[4] = { 1, 2, 4, 8 };
+    const uint32x4_t bits = vld1q_u32 (laneBits);
+    for (int i = 0; i < 64; i += 4)
+    {
+        const float32x4_t mono = vmulq_n_f32 (vaddq_f32 (vld1q_f32 (a + i), vld1q_f32 (b + i)), 0.5f);
+        mask |= (uint64_t) vaddvq_u32 (vandq_u32 (vcltq_f32 (mono, vdupq_n_f32 (0.0f)), bits)) << i;
+    }
+#else
+    for (int i = 0; i < 64; ++i)
+        if ((a[i] + b[i]) * 0.5f < 0.0f)
+            mask |= (uint64_t) 1 << i;
+#endif
+    return mask;
+}
+
+// Minimal float vector for lane kernels: 8 lanes on AVX, 4 on SSE/NEON/scalar.
+#if INTERSECT_SIMD_AVX
+struct FloatVec
+{
+    static constexpr int kLanes = 8;
+    __m256 v;
+
+    static FloatVec load (const float* p) noexcept  { return { _mm256_loadu_ps (p) }; }
+    static FloatVec splat (float x) noexcept        { return { _mm256_set1_ps (x) }; }
+    void store (float* p) const noexcept            { _mm256_storeu_ps (p, v); }
+
+    friend FloatVec operator+ (FloatVec a, FloatVec b) noexcept { return { _mm256_add_ps (a.v, b.v) }; }
+    friend FloatVec operator- (FloatVec a, FloatVec b) noexcept { return { _mm256_sub_ps (a.v, b.v) }; }
+    friend FloatVec operator* (FloatVec a, FloatVec b) noexcept { return { _mm256_mul_ps (a.v, b.v) }; }
+};
+#elif INTERSECT_SIMD_SSE
+struct FloatVec
+{
+    static constexpr int kLanes = 4;
+    __m128 v;
+
+    static FloatVec load (const float* p) noexcept  { return { _mm_loadu_ps (p) }; }
+    static FloatVec splat (float x) noexcept        { return { _mm_set1_ps (x) }; }
+    void store (float* p) const noexcept            { _mm_storeu_ps (p, v); }
+
+    friend FloatVec operator+ (FloatVec a, FloatVec b) noexcept { return { _mm_add_ps (a.v, b.v) }; }
+    friend FloatVec operator- (FloatVec a, FloatVec b) noexcept { return { _mm_sub_ps (a.v, b.v) }; }
+    friend FloatVec operator* (FloatVec a, FloatVec b) noexcept { return { _mm_mul_ps (a.v, b.v) }; }
+};
+#elif INTERSECT_SIMD_NEON
+struct FloatVec
+{
+    static constexpr int kLanes = 4;
+    float32x4_t v;
+
+    static FloatVec load (const float* p) noexcept  { return { vld1q_f32 (p) }; }
+    static FloatVec splat (float x) noexcept        { return { vdupq_n_f32 (x) }; }
+    void store (float* p) const noexcept            { vst1q_f32 (p, v); }
+
+    friend FloatVec operator+ (FloatVec a, FloatVec b) noexcept { return { vaddq_f32 (a.v, b.v) }; }
+    friend FloatVec operator- (FloatVec a, FloatVec b) noexcept { return { vsubq_f32 (a.v, b.v) }; }
+    friend FloatVec operator* (FloatVec a, FloatVec b) noexcept { return { vmulq_f32 (a.v, b.v) }; }
+};
+#else
+struct FloatVec
+{
+    static constexpr int kLanes = 4;
+    float v[kLanes];
+
+    static FloatVec load (const float* p) noexcept
+    {
+        FloatVec r;
+        for (int i = 0; i < kLanes; ++i) r.v[i] = p[i];
+        return r;
+    }
+
+    static FloatVec splat (float x) noexcept
+    {
+        FloatVec r;
+        for (int i = 0; i < kLanes; ++i) r.v[i] = x;
+        return r;
+    }
+
+    void store (float* p) const noexcept
+    {
+        for (int i = 0; i < kLanes; ++i) p[i] = v[i];
+    }
+
+    friend FloatVec operator+ (FloatVec a, FloatVec b) noexcept { for (int i = 0; i < kLanes; ++i) a.v[i] += b.v[i]; return a; }
+    friend FloatVec operator- (FloatVec a, FloatVec b) noexcept { for (int i = 0; i < kLanes; ++i) a.v[i] -= b.v[i]; return a; }
+    friend FloatVec operator* (FloatVec a, FloatVec b) noexcept { for (int i = 0; i < kLanes; ++i) a.v[i] *= b.v[i]; return a; }
+};
+#endif
+
+} // namespace SimdOps
@@ -0,0 +1,131 @@
+#pragma once
+#include "SimdOps.h"
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// Polyphase Kaiser-windowed sinc tables for RepitchMode::Sinc.
+// Each band stores kPhases + 1 rows of kTaps coefficients normalised to unity DC gain.
+// The first band (unity speed and pitch-down) keeps the full Nyquist cutoff so its
+// sinc zeros fall on integer offsets and integer phases read samples back exactly;
+// the cost is a little aliasing just above Nyquist for slight pitch-ups. Higher
+// bands set the cutoff from the fastest speed they serve, so every speed in the
+// band stays alias-free; only speeds past the last band's top alias.
+class SincTable
+{
+public:
+    static constexpr int kTaps         = 16;
+    static constexpr int kLeadingTaps  = kTaps / 2 - 1;  // frames before the integer base
+    static constexpr int kTrailingTaps = kTaps / 2;      // frames after the integer base
+    static constexpr int kPhases       = 256;
+    static constexpr int kNumBands     = 5;              // half-octave pitch-up steps
+
+    // taps points at kTaps consecutive frames starting kLeadingTaps before the base frame.
+    float interpolate (const float* taps, float frac) const noexcept
+    {
+        const float scaled = frac * (float) kPhases;
+        int phase = (int) scaled;
+        phase = phase < 0 ? 0 : (phase >= kPhases ? kPhases - 1 : phase);
+        const float t = scaled - (float) phase;
+
+        const float* row = coeffs.data() + (size_t) phase * kTaps;
+        const float a = SimdOps::dot (taps, row, kTaps);
+        const float b = SimdOps::dot (taps, row + kTaps, kTaps);
+        return a + (b - a) * t;
+    }
+
+    // Picks the band for a playback speed ratio (>1 = pitched up).
+    static const SincTable& forRatio (double speed) noexcept;
+
+    // Builds the tables ahead of time so the first Sinc voice doesn't pay for it.
+    static void prewarm();
+
+private:
+    friend struct SincTableBank;
+
+    static constexpr double kBaseCutoff = 0.9;  // fraction of Nyquist before the band scaling
+    static constexpr double kKaiserBeta = 7.0;
+
+    // Fastest speed each band serves: 2^0.25, 2^0.75, 2^1.25, 2^1.75, 2^2.25.
+    static constexpr double kBandTopSpeeds[kNumBands] = { 1.189207, 1.681793, 2.378414, 3.363586, 4.756828 };
+
+    static double besselI0 (double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            const double r = x / (2.0 * k);
+            term *= r * r;
+            sum += term;
+            if (term < sum * 1.0e-12)
+                break;
+        }
+        return sum;
+    }
+
+    void build (double cutoff)
+    {
+        constexpr double pi = 3.14159265358979323846;
+        const double halfWidth = (double) kTaps / 2.0;
+        const double norm = besselI0 (kKaiserBeta);
+
+        for (int p = 0; p <= kPhases; ++p)
+        {
+            const double frac = (double) p / (double) kPhases;
+            float* row = coeffs.data() + (size_t) p * kTaps;
+            double sum = 0.0;
+
+            for (int j = 0; j < kTaps; ++j)
+            {
+                const double x = (double) (j - kLeadingTaps) - frac;
+                const double r = x / halfWidth;
+                const double window = std::abs (r) < 1.0
+                    ? besselI0 (kKaiserBeta * std::sqrt (1.0 - r * r)) / norm
+                    : 0.0;
+                const double arg = pi * cutoff * x;
+                const double sinc = std::abs (arg) < 1.0e-9 ? 1.0 : std::sin (arg) / arg;
+                const double h = cutoff * sinc * window;
+                row[j] = (float) h;
+                sum += h;
+            }
+
+            if (sum != 0.0)
+                for (int j = 0; j < kTaps; ++j)
+                    row[j] = (float) (row[j] / sum);
+        }
+    }
+
+    alignas (32) std::array<float, (size_t) (kPhases + 1) * kTaps> coeffs {};
+};
+
+struct SincTableBank
+{
+    SincTableBank()
+    {
+        tables[0].build (1.0);
+        for (int b = 1; b < SincTable::kNumBands; ++b)
+            tables[(size_t) b].build (SincTable::kBaseCutoff / SincTable::kBandTopSpeeds[b]);
+    }
+
+    static const SincTableBank& get()
+    {
+        static const SincTableBank bank;
+        return bank;
+    }
+
+    std::array<SincTable, SincTable::kNumBands> tables;
+};
+
+inline const SincTable& SincTable::forRatio (double speed) noexcept
+{
+    int band = 0;
+    while (band < kNumBands - 1 && speed > kBandTopSpeeds[band])
+        ++band;
+
+    return SincTableBank::get().tables[(size_t) band];
+}
+
+inline void SincTable::prewarm()
+{
+    (void) SincTableBank::get();
+}
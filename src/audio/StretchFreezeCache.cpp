@@ -0,0 +1,270 @@
+#include "StretchFreezeCache.h"
+#include "VoicePool.h"
+#include <algorithm>
+
+// Planar stereo float; renders carry no interleaved copy.
+static constexpr juce::int64 kBytesPerFrame = 2 * (juce::int64) sizeof (float);
+
+FrozenStretch::~FrozenStretch()
+{
+    StretchFreezeCache::totalBytes.fetch_sub (bytes, std::memory_order_relaxed);
+}
+
+StretchFreezeCache::StretchFreezeCache()
+    : juce::Thread ("StretchFreeze")
+{
+}
+
+StretchFreezeCache::~StretchFreezeCache()
+{
+    stop();
+}
+
+void StretchFreezeCache::start()
+{
+    if (! isThreadRunning())
+        startThread (juce::Thread::Priority::background);
+}
+
+void StretchFreezeCache::stop()
+{
+    stopThread (4000);
+
+    for (auto& slot : pending)
+        delete slot.exchange (nullptr, std::memory_order_acq_rel);
+
+    for (auto& frozen : active)
+    {
+        delete frozen;
+        frozen = nullptr;
+    }
+
+    while (retireFifo.getNumReady() > 0)
+    {
+        const auto scope = retireFifo.read (1);
+        delete (scope.blockSize1 > 0 ? retiring[(size_t) scope.startIndex1]
+                                     : retiring[(size_t) scope.startIndex2]);
+    }
+
+    retired.clear();
+    renderedKeys.fill ({});
+    for (auto& r : rejected)
+        r.store (false, std::memory_order_relaxed);
+    lastUsed.fill (0);
+    requestFifo.reset();
+    retireFifo.reset();
+}
+
+FrozenStretch* StretchFreezeCache::acquire (int sliceIdx, const StretchFreezeKey& key)
+{
+    if (! juce::isPositiveAndBelow (sliceIdx, SliceManager::kMaxSlices))
+        return nullptr;
+
+    auto& current = active[(size_t) sliceIdx];
+
+    // Adopt a newer render only when the one it replaces can be queued for retirement.
+    if (current == nullptr || retireFifo.getFreeSpace() > 0)
+    {
+        if (auto* fresh = pending[(size_t) sliceIdx].exchange (nullptr, std::memory_order_acq_rel))
+        {
+            retire (current);
+            current = fresh;
+        }
+    }
+
+    if (current == nullptr || ! (current->key == key))
+        return nullptr;
+
+    lastUsed[(size_t) sliceIdx] = ++useCounter;
+    current->voiceRefs.fetch_add (1, std::memory_order_relaxed);
+    return current;
+}
+
+void StretchFreezeCache::releaseVoiceRef (FrozenStretch*& frozen)
+{
+    if (frozen == nullptr)
+        return;
+
+    frozen->voiceRefs.fetch_sub (1, std::memory_order_release);
+    frozen = nullptr;
+}
+
+bool StretchFreezeCache::request (int sliceIdx, const StretchFreezeKey& key, const SampleData& sample)
+{
+    if (! juce::isPositiveAndBelow (sliceIdx, SliceManager::kMaxSlices)
+        || key.sampleGeneration == 0
+        || ! isThreadRunning())
+        return false;
+
+    const auto scope = requestFifo.write (1);
+    Request* slot = scope.blockSize1 > 0 ? &requests[(size_t) scope.startIndex1]
+                  : (scope.blockSize2 > 0 ? &requests[(size_t) scope.startIndex2] : nullptr);
+    if (slot == nullptr)
+        return false;
+
+    slot->sliceIdx = sliceIdx;
+    slot->key = key;
+    slot->sample = &sample;
+    return true;
+}
+
+void StretchFreezeCache::retireAll()
+{
+    for (int i = 0; i < SliceManager::kMaxSlices; ++i)
+    {
+        if (retireFifo.getFreeSpace() < 2)
+            return;
+
+        retire (pending[(size_t) i].exchange (nullptr, std::memory_order_acq_rel));
+        retire (active[(size_t) i]);
+        active[(size_t) i] = nullptr;
+    }
+}
+
+bool StretchFreezeCache::takeRejected (int sliceIdx)
+{
+    return juce::isPositiveAndBelow (sliceIdx, SliceManager::kMaxSlices)
+        && rejected[(size_t) sliceIdx].exchange (false, std::memory_order_acq_rel);
+}
+
+void StretchFreezeCache::evictLeastRecent()
+{
+    if (retireFifo.getFreeSpace() < 2)
+        return;
+
+    int victim = -1;
+    for (int i = 0; i < SliceManager::kMaxSlices; ++i)
+    {
+        if (active[(size_t) i] == nullptr)
+            continue;
+
+        // Wrapping distance from the newest use keeps the order valid across overflow.
+        if (victim < 0 || useCounter - lastUsed[(size_t) i] > useCounter - lastUsed[(size_t) victim])
+            victim = i;
+    }
+
+    if (victim < 0)
+        return;
+
+    retire (pending[(size_t) victim].exchange (nullptr, std::memory_order_acq_rel));
+    retire (active[(size_t) victim]);
+    active[(size_t) victim] = nullptr;
+}
+
+void StretchFreezeCache::retire (FrozenStretch* frozen)
+{
+    if (frozen == nullptr)
+        return;
+
+    const auto scope = retireFifo.write (1);
+    if (scope.blockSize1 > 0)
+        retiring[(size_t) scope.startIndex1] = frozen;
+    else if (scope.blockSize2 > 0)
+        retiring[(size_t) scope.startIndex2] = frozen;
+    else
+        jassertfalse;   // callers check free space first
+}
+
+void StretchFreezeCache::run()
+{
+    while (! threadShouldExit())
+    {
+        while (retireFifo.getNumReady() > 0)
+        {
+            const auto scope = retireFifo.read (1);
+            auto* frozen = scope.blockSize1 > 0 ? retiring[(size_t) scope.startIndex1]
+                                                : retiring[(size_t) scope.startIndex2];
+
+            // Let a later request re-render this key once its render is gone.
+            if (juce::isPositiveAndBelow (frozen->sliceIdx, SliceManager::kMaxSlices)
+                && renderedKeys[(size_t) frozen->sliceIdx] == frozen->key)
+                renderedKeys[(size_t) frozen->sliceIdx] = {};
+
+            retired.emplace_back (frozen);
+        }
+
+        freeUnreferenced();
+
+        Request r;
+        bool havePending = false;
+        {
+            const auto scope = requestFifo.read (1);
+            if (scope.blockSize1 > 0)
+            {
+                r = requests[(size_t) scope.startIndex1];
+                havePending = true;
+            }
+            else if (scope.blockSize2 > 0)
+            {
+                r = requests[(size_t) scope.startIndex2];
+                havePending = true;
+            }
+        }
+
+        if (havePending)
+            render (r);
+        else
+            wait (5);
+    }
+}
+
+void StretchFreezeCache::render (const Request& r)
+{
+    if (r.sample == nullptr || r.key == renderedKeys[(size_t) r.sliceIdx])
+        return;
+
+    const auto snapshot = r.sample->getSnapshot();
+    if (snapshot == nullptr || snapshot->generation != r.key.sampleGeneration)
+        return;
+
+    // Rendered length is the source span over the time ratio, capped like the render.
+    const double sourceFrames = (double) (r.key.endSample - r.key.startSample);
+    const double estimatedFrames = std::min (sourceFrames / std::max (0.01, (double) r.key.timeRatio),
+                                             kMaxRenderSeconds * r.key.sampleRate);
+    if (totalBytes.load (std::memory_order_relaxed) + (juce::int64) estimatedFrames * kBytesPerFrame > kMaxTotalBytes)
+    {
+        rejected[(size_t) r.sliceIdx].store (true, std::memory_order_release);
+        return;
+    }
+
+    SampleData source;
+    source.applySnapshot (snapshot);
+
+    if (! VoicePool::renderFrozenStretch (r.key, source, renderL, renderR))
+        return;
+
+    const int numFrames = (int) std::min (renderL.size(), renderR.size());
+    auto decoded = std::make_unique<SampleData::DecodedSample>();
+    decoded->buffer.setSize (2, numFrames);
+    decoded->buffer.copyFrom (0, 0, renderL.data(), numFrames);
+    decoded->buffer.copyFrom (1, 0, renderR.data(), numFrames);
+    decoded->decodedNumFrames = numFrames;
+    decoded->decodedSampleRate = r.key.sampleRate;
+    decoded->sourceNumFrames = numFrames;
+    decoded->sourceSampleRate = r.key.sampleRate;
+
+    auto frozen = std::make_unique<FrozenStretch>();
+    frozen->key = r.key;
+    frozen->sliceIdx = r.sliceIdx;
+    frozen->numFrames = numFrames;
+    frozen->sourceOrigin = r.key.reverse ? (double) (r.key.endSample - 1) : (double) r.key.startSample;
+    frozen->sourceStep = (r.key.reverse ? -1.0 : 1.0) * (double) r.key.timeRatio;
+    frozen->bytes = (juce::int64) numFrames * kBytesPerFrame;
+    totalBytes.fetch_add (frozen->bytes, std::memory_order_relaxed);
+    frozen->sample.applyDecodedSample (std::move (decoded));
+
+    renderedKeys[(size_t) r.sliceIdx] = r.key;
+
+    // A pending render the audio thread never adopted can be freed straight away.
+    delete pending[(size_t) r.sliceIdx].exchange (frozen.release(), std::memory_order_acq_rel);
+}
+
+void StretchFreezeCache::freeUnreferenced()
+{
+    retired.erase (std::remove_if (retired.begin(), retired.end(),
+                                   [] (const std::unique_ptr<FrozenStretch>& frozen)
+                                   {
+                                       return frozen->voiceRefs.load (std::memory_order_acquire) <= 0;
+                                   }),
+                   retired.end());
+}
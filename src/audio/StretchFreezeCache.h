@@ -0,0 +1,119 @@
+#pragma once
+#include "SampleData.h"
+#include "SliceManager.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Resolved parameters that fully determine a slice's stretched output when it
+// plays once through (no loop, no release tail).
+struct StretchFreezeKey
+{
+    uint32_t sampleGeneration = 0;   // 0 = slice not eligible
+    int    startSample   = 0;
+    int    endSample     = 0;
+    int    algorithm     = 0;        // 1=Signalsmith, 2=Bungee
+    bool   reverse       = false;
+    float  timeRatio     = 1.0f;     // DAW BPM / slice BPM, or 1 without stretch
+    float  pitchSemis    = 0.0f;
+    float  tonalityHz    = 0.0f;
+    float  formantSemis  = 0.0f;
+    bool   formantComp   = false;
+    int    grainMode     = 1;
+    double sampleRate    = 0.0;
+
+    bool operator== (const StretchFreezeKey&) const = default;
+};
+
+// A slice's stretched output rendered offline, played back through the repitch path.
+struct FrozenStretch
+{
+    StretchFreezeKey key;
+    int sliceIdx = -1;
+    SampleData sample;            // private instance holding the rendered audio
+    int numFrames = 0;
+    double sourceOrigin = 0.0;    // source frame under rendered frame 0 (UI cursor)
+    double sourceStep = 1.0;      // source frames per rendered frame, signed
+    juce::int64 bytes = 0;        // counted against StretchFreezeCache's process-wide budget
+    std::atomic<int> voiceRefs { 0 };
+
+    ~FrozenStretch();
+};
+
+// Background "freeze" renders for slices whose stretch settings are static.
+// The worker publishes finished renders into per-slice pending slots; the audio
+// thread adopts them on note-on and retires the ones they replace. A retired
+// render is freed by the worker once no voice references it.
+//
+// Renders from every instance in the process share one byte budget. The worker
+// turns down a render that would not fit and flags its slice; the audio thread
+// then evicts its least recently played render to make room.
+class StretchFreezeCache : private juce::Thread
+{
+public:
+    static constexpr double kMaxRenderSeconds = 120.0;
+    static constexpr juce::int64 kMaxTotalBytes = 256ll * 1024 * 1024;
+    static constexpr int kRequestCapacity = 256;
+    static constexpr int kRetireCapacity  = 2 * SliceManager::kMaxSlices;
+
+    StretchFreezeCache();
+    ~StretchFreezeCache() override;
+
+    // Message thread with audio stopped; voices must have dropped their references.
+    void start();
+    void stop();
+
+    // Audio thread. Returns the render for key with a voice reference taken, or nullptr.
+    FrozenStretch* acquire (int sliceIdx, const StretchFreezeKey& key);
+    static void releaseVoiceRef (FrozenStretch*& frozen);
+
+    // Audio thread. Queues a background render for sliceIdx.
+    bool request (int sliceIdx, const StretchFreezeKey& key, const SampleData& sample);
+
+    // Audio thread. Retires every published render (e.g. freeze switched off).
+    void retireAll();
+
+    // Audio thread. True once if the worker turned down sliceIdx's last request
+    // for lack of budget, so it can be asked for again.
+    bool takeRejected (int sliceIdx);
+
+    // Audio thread. Retires the least recently played render to free budget.
+    void evictLeastRecent();
+
+    // Bytes held by renders of every instance in the process.
+    static juce::int64 getTotalBytes() { return totalBytes.load (std::memory_order_relaxed); }
+
+private:
+    struct Request
+    {
+        int sliceIdx = -1;
+        StretchFreezeKey key;
+        const SampleData* sample = nullptr;
+    };
+
+    void run() override;
+    void render (const Request& r);
+    void retire (FrozenStretch* frozen);
+    void freeUnreferenced();
+
+    friend struct FrozenStretch;
+    static inline std::atomic<juce::int64> totalBytes { 0 };
+
+    std::array<std::atomic<FrozenStretch*>, SliceManager::kMaxSlices> pending {};
+    std::array<std::atomic<bool>, SliceManager::kMaxSlices> rejected {};
+    std::array<FrozenStretch*, SliceManager::kMaxSlices> active {};   // audio thread only
+    std::array<uint32_t, SliceManager::kMaxSlices> lastUsed {};      // audio thread only
+    uint32_t useCounter = 0;                                          // audio thread only
+
+    juce::AbstractFifo requestFifo { kRequestCapacity };
+    std::array<Request, kRequestCapacity> requests;
+    juce::AbstractFifo retireFifo { kRetireCapacity };
+    std::array<FrozenStretch*, kRetireCapacity> retiring {};
+
+    // Worker-thread state
+    std::array<StretchFreezeKey, SliceManager::kMaxSlices> renderedKeys {};
+    std::vector<std::unique_ptr<FrozenStretch>> retired;
+    std::vector<float> renderL, renderR;
+};
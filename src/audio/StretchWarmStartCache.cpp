@@ -0,0 +1,265 @@
+#include "StretchWarmStartCache.h"
+#include "signalsmith-stretch.h"
+#include <algorithm>
+
+StretchWarmStartCache::StretchWarmStartCache()
+    : juce::Thread ("StretchWarmStart")
+{
+    idle.reserve ((size_t) kNumEntries);
+    seekBufL.resize ((size_t) kMaxSeekFrames, 0.0f);
+    seekBufR.resize ((size_t) kMaxSeekFrames, 0.0f);
+}
+
+StretchWarmStartCache::~StretchWarmStartCache()
+{
+    stopThread (2000);
+}
+
+void StretchWarmStartCache::stop()
+{
+    stopThread (2000);
+
+    for (auto& slot : ready)
+        slot.store (nullptr, std::memory_order_relaxed);
+    for (auto& t : lastTriggered)
+        t.store (0, std::memory_order_relaxed);
+
+    for (auto& e : entries)
+    {
+        if (pool != nullptr)
+            pool->releaseSignalsmith (e.stretcher);
+        e = {};
+    }
+
+    idle.clear();
+    requestFifo.reset();
+}
+
+void StretchWarmStartCache::prepare (StretcherPool& poolToUse)
+{
+    stop();
+    pool = &poolToUse;
+
+    // Entries get their instance the first time they are primed.
+    for (auto& e : entries)
+        idle.push_back (&e);
+
+    startThread (juce::Thread::Priority::background);
+}
+
+StretchWarmStartCache::Entry* StretchWarmStartCache::take (int sliceIdx, const StretchWarmStartKey& key,
+                                                           const SampleData& sample)
+{
+    if (! juce::isPositiveAndBelow (sliceIdx, SliceManager::kMaxSlices))
+        return nullptr;
+
+    lastTriggered[(size_t) sliceIdx].store (++triggerCounter, std::memory_order_relaxed);
+
+    auto* entry = ready[(size_t) sliceIdx].exchange (nullptr, std::memory_order_acq_rel);
+    if (entry == nullptr)
+        return nullptr;
+
+    if (entry->key == key)
+        return entry;
+
+    // Stale (slice edited, params or tempo changed): re-prime it for the new key.
+    Request r;
+    r.sliceIdx = sliceIdx;
+    r.key = key;
+    r.entry = entry;
+    r.sample = &sample;
+    r.fromTrigger = true;
+
+    const bool queued = push (r);
+    jassert (queued);
+    juce::ignoreUnused (queued);
+    return nullptr;
+}
+
+void StretchWarmStartCache::giveBack (int sliceIdx, Entry* entry, const SampleData& sample)
+{
+    if (entry == nullptr)
+        return;
+
+    Request r;
+    r.sliceIdx = sliceIdx;
+    r.key = entry->key;
+    r.entry = entry;
+    r.sample = &sample;
+    r.fromTrigger = true;
+
+    // Entry requests always fit: null-entry requests leave room for every entry.
+    const bool queued = push (r);
+    jassert (queued);
+    juce::ignoreUnused (queued);
+}
+
+bool StretchWarmStartCache::request (int sliceIdx, const StretchWarmStartKey& key,
+                                     const SampleData& sample, bool fromTrigger)
+{
+    if (! juce::isPositiveAndBelow (sliceIdx, SliceManager::kMaxSlices)
+        || ! isThreadRunning()
+        || requestFifo.getFreeSpace() <= kNumEntries)
+        return false;
+
+    Request r;
+    r.sliceIdx = sliceIdx;
+    r.key = key;
+    r.sample = &sample;
+    r.fromTrigger = fromTrigger;
+    return push (r);
+}
+
+bool StretchWarmStartCache::push (const Request& r)
+{
+    const auto scope = requestFifo.write (1);
+    if (scope.blockSize1 > 0)
+        requests[(size_t) scope.startIndex1] = r;
+    else if (scope.blockSize2 > 0)
+        requests[(size_t) scope.startIndex2] = r;
+    else
+        return false;
+    return true;
+}
+
+bool StretchWarmStartCache::pop (Request& r)
+{
+    const auto scope = requestFifo.read (1);
+    if (scope.blockSize1 > 0)
+        r = requests[(size_t) scope.startIndex1];
+    else if (scope.blockSize2 > 0)
+        r = requests[(size_t) scope.startIndex2];
+    else
+        return false;
+    return true;
+}
+
+void StretchWarmStartCache::run()
+{
+    while (! threadShouldExit())
+    {
+        // Raising the voice count asks for more stretchers; build them off the audio thread.
+        pool->topUp();
+
+        Request r;
+        if (pop (r))
+            handleRequest (r);
+        else
+            wait (5);
+    }
+}
+
+void StretchWarmStartCache::handleRequest (const Request& r)
+{
+    auto& slot = ready[(size_t) r.sliceIdx];
+    Entry* entry = r.entry;
+
+    if (entry == nullptr)
+    {
+        // Only this thread writes entry keys, so peeking at a published entry is safe
+        // even if the audio thread takes it meanwhile.
+        if (auto* current = slot.load (std::memory_order_acquire))
+            if (current->key == r.key)
+                return;
+
+        if (! idle.empty())
+        {
+            entry = idle.back();
+            idle.pop_back();
+        }
+        else if (r.fromTrigger)
+        {
+            entry = evictLeastRecent (r.sliceIdx);
+        }
+
+        if (entry == nullptr)
+            return;
+    }
+
+    if (! prime (*entry, r))
+    {
+        idle.push_back (entry);
+        return;
+    }
+
+    if (auto* previous = slot.exchange (entry, std::memory_order_acq_rel))
+        idle.push_back (previous);
+}
+
+bool StretchWarmStartCache::prime (Entry& entry, const Request& r)
+{
+    if (r.sample == nullptr)
+        return false;
+
+    // Built here rather than taken from the voices' free list, which only the
+    // audio thread touches.
+    if (entry.stretcher == nullptr)
+        entry.stretcher = pool->createSignalsmith();
+    if (entry.stretcher == nullptr)
+        return false;
+
+    const auto snapshot = r.sample->getSnapshot();
+    if (snapshot == nullptr || snapshot->generation != r.key.sampleGeneration)
+        return false;
+
+    const int numFrames = snapshot->getNumFrames();
+    if (numFrames <= 0 || (snapshot->compact == nullptr && snapshot->buffer.getNumChannels() <= 0))
+        return false;
+
+    auto& stretcher = *entry.stretcher;
+    stretcher.reset();
+    stretcher.setTransposeSemitones (r.key.pitchSemis, r.key.tonalityLimit);
+    stretcher.setFormantSemitones (r.key.formantSemis, r.key.formantComp);
+
+    int seekLen = stretcher.outputSeekLength (r.key.timeRatio);
+    seekLen = std::min (seekLen, r.key.activeLength);
+    seekLen = juce::jlimit (0, kMaxSeekFrames, seekLen);
+
+    if (seekLen > 0)
+    {
+        // Same frames reseekStretcher() reads: the seek never leaves the active region.
+        for (int i = 0; i < seekLen; ++i)
+        {
+            const int frame = juce::jlimit (0, numFrames - 1, r.key.startFrame + r.key.direction * i);
+            seekBufL[(size_t) i] = snapshot->getSample (frame, 0);
+            seekBufR[(size_t) i] = snapshot->getSample (frame, 1);
+        }
+
+        float* ptrs[2] = { seekBufL.data(), seekBufR.data() };
+        stretcher.outputSeek (ptrs, seekLen);
+    }
+
+    entry.key = r.key;
+    entry.seekLength = seekLen;
+    return true;
+}
+
+StretchWarmStartCache::Entry* StretchWarmStartCache::evictLeastRecent (int keepSliceIdx)
+{
+    for (;;)
+    {
+        const uint32_t newest = lastTriggered[(size_t) keepSliceIdx].load (std::memory_order_relaxed);
+        int victim = -1;
+        uint32_t oldest = 0;
+
+        for (int i = 0; i < SliceManager::kMaxSlices; ++i)
+        {
+            if (i == keepSliceIdx || ready[(size_t) i].load (std::memory_order_relaxed) == nullptr)
+                continue;
+
+            // Wrapping distance from the triggering slice keeps the order valid across overflow.
+            const uint32_t age = newest - lastTriggered[(size_t) i].load (std::memory_order_relaxed);
+            if (victim < 0 || age > oldest)
+            {
+                victim = i;
+                oldest = age;
+            }
+        }
+
+        if (victim < 0)
+            return nullptr;
+
+        if (auto* entry = ready[(size_t) victim].exchange (nullptr, std::memory_order_acq_rel))
+            return entry;
+    }
+}
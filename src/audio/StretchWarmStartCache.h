@@ -0,0 +1,98 @@
+#pragma once
+#include "StretcherPool.h"
+#include "SampleData.h"
+#include "SliceManager.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+// Everything that shapes a Signalsmith stretcher's state right after the note-on seek.
+struct StretchWarmStartKey
+{
+    uint32_t sampleGeneration = 0;
+    int   startFrame     = 0;   // first source frame fed to the seek
+    int   activeLength   = 0;   // caps the seek length, as in reseekStretcher()
+    int   direction      = 1;
+    float timeRatio      = 1.0f;
+    float pitchSemis     = 0.0f;
+    float tonalityLimit  = 0.0f;
+    float formantSemis   = 0.0f;
+    bool  formantComp    = false;
+
+    bool operator== (const StretchWarmStartKey&) const = default;
+};
+
+// Per-slice Signalsmith instances that a background thread has already reset,
+// tuned and seeked to the slice start. On note-on the voice swaps its own
+// instance for the primed one, skipping the seek's FFT burst on the trigger
+// block; the swapped-out instance goes back to the worker to be primed again.
+//
+// Ownership moves through atomic exchanges on the per-slice slots and a
+// single-producer FIFO, so the audio thread never locks or allocates.
+class StretchWarmStartCache : private juce::Thread
+{
+public:
+    using SignalsmithStretcher = StretcherPool::SignalsmithStretcher;
+
+    static constexpr int kNumEntries     = 16;
+    static constexpr int kMaxSeekFrames  = 8192;   // matches the shared stretch input scratch
+    static constexpr int kRequestCapacity = 256;
+
+    struct Entry
+    {
+        StretchWarmStartKey key;
+        SignalsmithStretcher* stretcher = nullptr;
+        int seekLength = 0;   // source frames consumed by the seek
+    };
+
+    StretchWarmStartCache();
+    ~StretchWarmStartCache() override;
+
+    // Message thread with audio stopped. stop() returns every entry's instance so
+    // the pool can be rebuilt; prepare() starts the worker, which also builds the
+    // pool's stretchers for added voices. Entries get their own instance from the
+    // pool the first time they are primed.
+    void stop();
+    void prepare (StretcherPool& poolToUse);
+
+    // Audio thread. Returns a primed entry whose key matches, or nullptr.
+    // A taken entry must be handed back through giveBack().
+    Entry* take (int sliceIdx, const StretchWarmStartKey& key, const SampleData& sample);
+    void giveBack (int sliceIdx, Entry* entry, const SampleData& sample);
+
+    // Audio thread. Asks the worker to prime sliceIdx for key. Trigger-driven
+    // requests may evict the least recently played slice when no entry is free.
+    bool request (int sliceIdx, const StretchWarmStartKey& key, const SampleData& sample, bool fromTrigger);
+
+private:
+    struct Request
+    {
+        int sliceIdx = -1;
+        StretchWarmStartKey key;
+        Entry* entry = nullptr;
+        const SampleData* sample = nullptr;
+        bool fromTrigger = false;
+    };
+
+    void run() override;
+    bool push (const Request& r);
+    bool pop (Request& r);
+    void handleRequest (const Request& r);
+    bool prime (Entry& entry, const Request& r);
+    Entry* evictLeastRecent (int keepSliceIdx);
+
+    std::array<std::atomic<Entry*>, SliceManager::kMaxSlices> ready {};
+    std::array<std::atomic<uint32_t>, SliceManager::kMaxSlices> lastTriggered {};
+    uint32_t triggerCounter = 0;   // audio thread only
+
+    juce::AbstractFifo requestFifo { kRequestCapacity };
+    std::array<Request, kRequestCapacity> requests;
+
+    StretcherPool* pool = nullptr;
+
+    // Worker-thread state
+    std::array<Entry, kNumEntries> entries;
+    std::vector<Entry*> idle;
+    std::vector<float> seekBufL, seekBufR;
+};
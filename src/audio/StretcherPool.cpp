@@ -0,0 +1,182 @@
+#include "StretcherPool.h"
+#include "signalsmith-stretch.h"
+#include "bungee/Bungee.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+
+template <typename T>
+void StretcherPool::FreeList<T>::reset (int newCapacity)
+{
+    capacity = newCapacity;
+    available.clear();
+    storage.clear();
+    storage.reserve ((size_t) capacity);
+    available.reserve ((size_t) capacity);
+
+    // AbstractFifo keeps one slot empty.
+    incoming.assign ((size_t) capacity + 1, nullptr);
+    incomingFifo = std::make_unique<juce::AbstractFifo> (capacity + 1);
+}
+
+template <typename T>
+T* StretcherPool::FreeList<T>::pop()
+{
+    if (available.empty())
+        drainIncoming();
+    if (available.empty())
+        return nullptr;
+
+    T* item = available.back();
+    available.pop_back();
+    return item;
+}
+
+template <typename T>
+void StretcherPool::FreeList<T>::push (T* item)
+{
+    // Capacity covers every instance that can exist, so this never reallocates.
+    if (item != nullptr && (int) available.size() < capacity)
+        available.push_back (item);
+}
+
+template <typename T>
+void StretcherPool::FreeList<T>::add (std::unique_ptr<T> item)
+{
+    T* raw = item.get();
+    storage.push_back (std::move (item));
+    push (raw);
+}
+
+template <typename T>
+void StretcherPool::FreeList<T>::hand (std::unique_ptr<T> item)
+{
+    T* raw = item.get();
+    storage.push_back (std::move (item));
+
+    const auto scope = incomingFifo->write (1);
+    if (scope.blockSize1 > 0)
+        incoming[(size_t) scope.startIndex1] = raw;
+    else if (scope.blockSize2 > 0)
+        incoming[(size_t) scope.startIndex2] = raw;
+}
+
+template <typename T>
+void StretcherPool::FreeList<T>::drainIncoming()
+{
+    const auto scope = incomingFifo->read (incomingFifo->getNumReady());
+    for (int i = 0; i < scope.blockSize1; ++i)
+        push (incoming[(size_t) (scope.startIndex1 + i)]);
+    for (int i = 0; i < scope.blockSize2; ++i)
+        push (incoming[(size_t) (scope.startIndex2 + i)]);
+}
+
+StretcherPool::StretcherPool() = default;
+StretcherPool::~StretcherPool() = default;
+
+void StretcherPool::prepare (double sampleRate, int numVoices, int maxVoices, int maxExtraSignalsmith)
+{
+    preparedSampleRate = sampleRate;
+    maxBungeeInputFrames = 0;
+    maxVoiceSets = std::max (0, maxVoices);
+    numVoices = juce::jlimit (0, maxVoiceSets, numVoices);
+
+    signalsmith.reset (maxVoiceSets + std::max (0, maxExtraSignalsmith));
+    for (auto& list : bungee)
+        list.reset (maxVoiceSets);
+
+    for (int i = 0; i < numVoices; ++i)
+    {
+        signalsmith.add (makeSignalsmith());
+        for (int mode = 0; mode < kNumBungeeHopModes; ++mode)
+            bungee[(size_t) mode].add (makeBungee (mode));
+    }
+
+    numVoicesRequested.store (numVoices, std::memory_order_relaxed);
+    numVoicesBuilt.store (numVoices, std::memory_order_release);
+}
+
+void StretcherPool::requestVoices (int numVoices)
+{
+    numVoicesRequested.store (juce::jlimit (0, maxVoiceSets, numVoices), std::memory_order_relaxed);
+}
+
+int StretcherPool::getNumVoicesReady()
+{
+    return numVoicesBuilt.load (std::memory_order_acquire);
+}
+
+void StretcherPool::topUp()
+{
+    if (preparedSampleRate <= 0.0)
+        return;
+
+    // The pool never shrinks: a lowered voice count keeps its sets for next time.
+    for (int built = numVoicesBuilt.load (std::memory_order_relaxed);
+         built < numVoicesRequested.load (std::memory_order_relaxed); ++built)
+    {
+        signalsmith.hand (makeSignalsmith());
+        for (int mode = 0; mode < kNumBungeeHopModes; ++mode)
+            bungee[(size_t) mode].hand (makeBungee (mode));
+
+        numVoicesBuilt.store (built + 1, std::memory_order_release);
+    }
+}
+
+StretcherPool::SignalsmithStretcher* StretcherPool::createSignalsmith()
+{
+    if (preparedSampleRate <= 0.0 || (int) signalsmith.storage.size() >= signalsmith.capacity)
+        return nullptr;
+
+    signalsmith.storage.push_back (makeSignalsmith());
+    return signalsmith.storage.back().get();
+}
+
+std::unique_ptr<StretcherPool::SignalsmithStretcher> StretcherPool::makeSignalsmith() const
+{
+    auto s = std::make_unique<SignalsmithStretcher>();
+    configureSignalsmith (*s, preparedSampleRate);
+    return s;
+}
+
+std::unique_ptr<StretcherPool::BungeeStretcher> StretcherPool::makeBungee (int mode)
+{
+    Bungee::SampleRates rates;
+    rates.input  = (int) preparedSampleRate;
+    rates.output = (int) preparedSampleRate;
+
+    auto s = std::make_unique<BungeeStretcher> (rates, 2, kMinBungeeHopAdjust + mode);
+    maxBungeeInputFrames = std::max (maxBungeeInputFrames, s->maxInputFrameCount());
+    return s;
+}
+
+StretcherPool::SignalsmithStretcher* StretcherPool::acquireSignalsmith()
+{
+    return signalsmith.pop();
+}
+
+void StretcherPool::releaseSignalsmith (SignalsmithStretcher* s)
+{
+    signalsmith.push (s);
+}
+
+StretcherPool::BungeeStretcher* StretcherPool::acquireBungee (int hopAdjust)
+{
+    return bungee[(size_t) (clampBungeeHopAdjust (hopAdjust) - kMinBungeeHopAdjust)].pop();
+}
+
+void StretcherPool::releaseBungee (BungeeStretcher* s, int hopAdjust)
+{
+    bungee[(size_t) (clampBungeeHopAdjust (hopAdjust) - kMinBungeeHopAdjust)].push (s);
+}
+
+void StretcherPool::configureSignalsmith (SignalsmithStretcher& s, double sampleRate)
+{
+    const int blockSize = std::max (256, (int) (sampleRate * 0.023));   // ~1024 @ 44.1k (~23ms)
+    const int interval  = std::max (64,  (int) (sampleRate * 0.006));   // ~256 @ 44.1k (~6ms)
+    s.configure (2, blockSize, interval, false);
+}
+
+int StretcherPool::clampBungeeHopAdjust (int grainMode)
+{
+    return juce::jlimit (kMinBungeeHopAdjust, kMinBungeeHopAdjust + kNumBungeeHopModes - 1, grainMode);
+}
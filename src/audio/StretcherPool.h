@@ -0,0 +1,94 @@
+#pragma once
+#include "Voice.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Pre-built Signalsmith and Bungee instances handed to voices on note-on and
+// returned when they finish. prepare() builds one Signalsmith and one Bungee per
+// hop mode for every voice that can sound at once, so note-on always finds one.
+// When the voice count is raised, topUp() builds the extra sets off the audio
+// thread and hands them over through a single-producer FIFO; the voice pool
+// only admits the new voices once their sets are ready.
+//
+// The free lists belong to the audio thread: acquire/release are a pointer move
+// on a fixed-capacity array, with no locks and no allocation.
+class StretcherPool
+{
+public:
+    using SignalsmithStretcher = signalsmith::stretch::SignalsmithStretch<float, void>;
+    using BungeeStretcher      = Bungee::Stretcher<Bungee::Basic>;
+
+    // Bungee log2 synthesis hop adjustments: -1 (fine grain) and 0 (default).
+    static constexpr int kMinBungeeHopAdjust = -1;
+    static constexpr int kNumBungeeHopModes  = 2;
+
+    StretcherPool();
+    ~StretcherPool();
+
+    // Message thread, nothing else using the pool. Drops every instance and builds
+    // sets for numVoices voices at the given rate; maxVoices and maxExtraSignalsmith
+    // size the lists. Pointers handed out earlier become invalid, so callers must
+    // drop them first.
+    void prepare (double sampleRate, int numVoices, int maxVoices, int maxExtraSignalsmith);
+    double getPreparedSampleRate() const { return preparedSampleRate; }
+
+    // Audio thread. Asks for sets for numVoices voices; topUp() builds the rest.
+    void requestVoices (int numVoices);
+
+    // Audio thread. Number of voices whose sets have reached the free lists.
+    int getNumVoicesReady();
+
+    // Background thread (one at a time). Builds the sets requestVoices() asked for.
+    void topUp();
+
+    // Background thread (one at a time). A Signalsmith instance outside the voice
+    // sets, for callers that keep their own (the warm-start cache). It may be
+    // passed to releaseSignalsmith() once the audio thread owns it.
+    SignalsmithStretcher* createSignalsmith();
+
+    // Largest grain input any pooled Bungee instance asks for (sizes shared scratch).
+    int getMaxBungeeInputFrames() const { return maxBungeeInputFrames; }
+
+    // Audio thread. Return nullptr only if the pool was never prepared.
+    SignalsmithStretcher* acquireSignalsmith();
+    void releaseSignalsmith (SignalsmithStretcher* s);
+
+    BungeeStretcher* acquireBungee (int hopAdjust);
+    void releaseBungee (BungeeStretcher* s, int hopAdjust);
+
+    static int clampBungeeHopAdjust (int grainMode);
+    static void configureSignalsmith (SignalsmithStretcher& s, double sampleRate);
+
+private:
+    template <typename T>
+    struct FreeList
+    {
+        std::vector<std::unique_ptr<T>> storage;   // prepare() and the building thread only
+        std::vector<T*> available;                 // audio thread; capacity reserved up front
+        std::vector<T*> incoming;                  // built off the audio thread, not yet taken
+        std::unique_ptr<juce::AbstractFifo> incomingFifo;
+        int capacity = 0;   // instances this list can ever hold
+
+        void reset (int newCapacity);
+        T* pop();
+        void push (T* item);
+        void add (std::unique_ptr<T> item);   // prepare() only
+        void hand (std::unique_ptr<T> item);  // building thread
+        void drainIncoming();
+    };
+
+    std::unique_ptr<SignalsmithStretcher> makeSignalsmith() const;
+    std::unique_ptr<BungeeStretcher> makeBungee (int mode);
+
+    FreeList<SignalsmithStretcher> signalsmith;
+    std::array<FreeList<BungeeStretcher>, kNumBungeeHopModes> bungee;
+    double preparedSampleRate = 0.0;
+    int maxBungeeInputFrames = 0;
+    int maxVoiceSets = 0;
+
+    std::atomic<int> numVoicesRequested { 0 };
+    std::atomic<int> numVoicesBuilt { 0 };   // sets handed over, written by the building thread
+};
@@ -15,6 +15,8 @@ namespace Bungee {
     template<class Edition> struct Stretcher;
 }
 
+struct FrozenStretch;
+
 struct Voice
 {
     bool         active       = false;
@@ -63,15 +65,17 @@ struct Voice
     SvfFilter::SvfCoeffs filterCoeffs;
     int          filterCoeffCounter = 0;
 
+    // Freeze: pre-rendered stretch output played through the repitch path
+    FrozenStretch* frozen = nullptr;   // holds a voice reference (StretchFreezeCache)
+
     // Crossfade fields
     float        crossfadePct      = 0.0f;
     int          crossfadeLenSamples = 0;
 
     // Signalsmith stretch fields
     bool         stretchActive = false;
-    std::shared_ptr<signalsmith::stretch::SignalsmithStretch<float, void>> stretcher;
-    std::vector<float> stretchInBufL, stretchInBufR;
-    std::vector<float> stretchOutBufL, stretchOutBufR;
+    signalsmith::stretch::SignalsmithStretch<float, void>* stretcher = nullptr;  // borrowed from StretcherPool
+    std::vector<float> stretchOutBufL, stretchOutBufR;   // one output block carried between samples
     int          stretchOutReadPos  = 0;
     int          stretchOutAvail    = 0;
     double       stretchSrcPos      = 0.0;
@@ -81,9 +85,10 @@ struct Voice
 
     // Bungee stretch fields
     bool         bungeeActive       = false;
-    std::shared_ptr<Bungee::Stretcher<Bungee::Basic>> bungeeStretcher;
-    std::vector<float> bungeeInputBuf;   // interleaved per-channel input buffer
-    std::vector<float> bungeeOutBufL, bungeeOutBufR;
+    Bungee::Stretcher<Bungee::Basic>* bungeeStretcher = nullptr;  // borrowed from StretcherPool
+    int          bungeeHopAdjust    = 0;
+    const float* bungeeOutL = nullptr;   // last synthesised grain, owned by bungeeStretcher
+    const float* bungeeOutR = nullptr;
     int          bungeeOutReadPos   = 0;
     int          bungeeOutAvail     = 0;
     double       bungeeSrcPos       = 0.0;
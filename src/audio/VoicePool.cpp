@@ -1,4 +1,7 @@
 #include "VoicePool.h"
+#include "SampleStreamer.h"
+#include "SincTable.h"
+#include "SimdOps.h"
 #include "../Constants.h"
 
 // Include Signalsmith Stretch
@@ -9,11 +12,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 static constexpr int kStretchBlockSize = 128;        // required block size for Signalsmith Stretch processing
 static constexpr int kMaxStretchInputSamples = 8192; // max pre-roll/input feed size (empirically tuned)
-static constexpr int kMaxBungeeInputFrames = 8192;
-static constexpr int kMaxBungeeOutputFrames = 8192;
+static_assert (StretchWarmStartCache::kMaxSeekFrames == kMaxStretchInputSamples);
+static constexpr int kVoiceRunSize = 64;             // max samples rendered per steady voice run
+static constexpr int kCompactWindowFrames = 1024;    // float window a compact-storage repitch run reads
 
 enum class PlaybackDirection
 {
@@ -31,7 +36,7 @@ enum class VoiceBoundaryAction
 };
 
 // Forward declaration — defined below, used by initStretcher
-static void reseekStretcher (Voice& v, const SampleData& sample, bool consumeSource);
+static void reseekStretcher (Voice& v, StretchScratch& scratch, const SampleData& sample, bool consumeSource);
 
 static PlaybackDirection getPlaybackDirection (double step)
 {
@@ -154,6 +159,12 @@ static double reflectPingPongPosition (double pos, int start, int end)
         return lo + (fullCycle - t);
 }
 
+// Frozen voices read their pre-rendered stretch instead of the session sample.
+static const SampleData& getVoiceSource (const Voice& v, const SampleData& sessionSample)
+{
+    return v.frozen != nullptr ? v.frozen->sample : sessionSample;
+}
+
 static float readClampedSample (const SampleData& sample, double pos, int channel)
 {
     const int maxFrame = sample.getNumFrames() - 1;
@@ -163,6 +174,13 @@ static float readClampedSample (const SampleData& sample, double pos, int channe
     return sample.getInterpolatedSample (juce::jlimit (0.0, (double) maxFrame, pos), channel);
 }
 
+// Streamed and compact samples have no float buffer to index, so go through the frame accessor.
+static float lerpAccessorFrames (const SampleData& sample, int channel, int frame0, int frame1, float frac)
+{
+    const float s0 = sample.getSampleAtFrame (frame0, channel);
+    return s0 + (sample.getSampleAtFrame (frame1, channel) - s0) * frac;
+}
+
 static float readBoundedSliceSample (const SampleData& sample, double pos,
                                      int channel, int start, int end)
 {
@@ -170,6 +188,16 @@ static float readBoundedSliceSample (const SampleData& sample, double pos,
     if (sliceLen <= 0)
         return 0.0f;
 
+    const double clampedPos = juce::jlimit ((double) start,
+                                            (double) juce::jmax (start, end - 1),
+                                            pos);
+    const int frame0 = juce::jlimit (start, end - 1, (int) std::floor (clampedPos));
+    const float frac = (float) (clampedPos - std::floor (clampedPos));
+    const int frame1 = juce::jlimit (start, end - 1, frame0 + 1);
+
+    if (! sample.hasDirectBuffer())
+        return lerpAccessorFrames (sample, channel, frame0, frame1, frac);
+
     const auto& buffer = sample.getBuffer();
     if (channel < 0 || channel >= buffer.getNumChannels())
         return 0.0f;
@@ -178,13 +206,6 @@ static float readBoundedSliceSample (const SampleData& sample, double pos,
     if (data == nullptr)
         return 0.0f;
 
-    const double clampedPos = juce::jlimit ((double) start,
-                                            (double) juce::jmax (start, end - 1),
-                                            pos);
-    const int frame0 = juce::jlimit (start, end - 1, (int) std::floor (clampedPos));
-    const float frac = (float) (clampedPos - std::floor (clampedPos));
-    const int frame1 = juce::jlimit (start, end - 1, frame0 + 1);
-
     return data[frame0] + (data[frame1] - data[frame0]) * frac;
 }
 
@@ -195,6 +216,14 @@ static float readWrappedLoopSample (const SampleData& sample, double pos,
     if (loopLen <= 0)
         return 0.0f;
 
+    const double wrappedPos = wrapLoopPosition (pos, start, end);
+    const int frame0 = juce::jlimit (start, end - 1, (int) std::floor (wrappedPos));
+    const float frac = (float) (wrappedPos - std::floor (wrappedPos));
+    const int frame1 = (frame0 + 1 < end) ? (frame0 + 1) : start;
+
+    if (! sample.hasDirectBuffer())
+        return lerpAccessorFrames (sample, channel, frame0, frame1, frac);
+
     const auto& buffer = sample.getBuffer();
     if (channel < 0 || channel >= buffer.getNumChannels())
         return 0.0f;
@@ -203,45 +232,105 @@ static float readWrappedLoopSample (const SampleData& sample, double pos,
     if (data == nullptr)
         return 0.0f;
 
-    const double wrappedPos = wrapLoopPosition (pos, start, end);
-    const int frame0 = juce::jlimit (start, end - 1, (int) std::floor (wrappedPos));
-    const float frac = (float) (wrappedPos - std::floor (wrappedPos));
-    const int frame1 = (frame0 + 1 < end) ? (frame0 + 1) : start;
-
     return data[frame0] + (data[frame1] - data[frame0]) * frac;
 }
 
 static RepitchMode getActiveRepitchMode (int storedMode)
 {
-    return storedMode == (int) RepitchMode::Cubic ? RepitchMode::Cubic
-                                                  : RepitchMode::Linear;
+    switch (storedMode)
+    {
+        case (int) RepitchMode::Cubic: return RepitchMode::Cubic;
+        case (int) RepitchMode::Sinc:  return RepitchMode::Sinc;
+        default:                       return RepitchMode::Linear;
+    }
+}
+
+// Interpolator choice for a repitch voice; Sinc also carries the band for its speed.
+struct RepitchKernel
+{
+    RepitchMode mode = RepitchMode::Linear;
+    const SincTable* sinc = nullptr;
+};
+
+static RepitchKernel getRepitchKernel (const Voice& v)
+{
+    RepitchKernel kernel;
+    kernel.mode = getActiveRepitchMode (v.repitchMode);
+    if (kernel.mode == RepitchMode::Sinc)
+        kernel.sinc = &SincTable::forRatio (v.speed);
+    return kernel;
+}
+
+// Stereo frame reader for the per-sample repitch path, resolved once per block.
+// Both channels of a frame come from one interleaved load when the sample has
+// an interleaved copy; otherwise they go through the per-channel accessor.
+// Frames outside the sample read as silence either way.
+struct RepitchSource
+{
+    const SampleData& sample;
+    SampleData::FrameView frames;
+    int numFrames = 0;
+
+    void readFrame (int frame, float& outL, float& outR) const
+    {
+        if (frames.data == nullptr)
+        {
+            outL = sample.getSampleAtFrame (frame, 0);
+            outR = sample.getSampleAtFrame (frame, 1);
+            return;
+        }
+
+        if ((unsigned) frame >= (unsigned) frames.numFrames)
+        {
+            outL = outR = 0.0f;
+            return;
+        }
+
+        const float* f = frames.data + 2 * (size_t) frame;
+        outL = f[0];
+        outR = f[1];
+    }
+};
+
+static RepitchSource makeRepitchSource (const SampleData& sample, const SampleData::FrameView& frames)
+{
+    return { sample, frames, sample.getNumFrames() };
 }
 
 template <typename FrameMapper>
-static float readMappedRepitchSample (const SampleData& sample, double pos, int channel,
-                                      RepitchMode mode, FrameMapper&& mapFrame)
+static void readMappedRepitchFrame (const RepitchSource& source, double pos, const RepitchKernel& kernel,
+                                    FrameMapper&& mapFrame, float& outL, float& outR)
 {
     const double baseFloor = std::floor (pos);
     const int base = (int) baseFloor;
     const float frac = (float) (pos - baseFloor);
 
-    const auto sampleAt = [&] (int frame)
+    if (kernel.sinc != nullptr)
     {
-        return sample.getSampleAtFrame (mapFrame (frame), channel);
-    };
+        float tapsL[SincTable::kTaps];
+        float tapsR[SincTable::kTaps];
+        for (int j = 0; j < SincTable::kTaps; ++j)
+            source.readFrame (mapFrame (base - SincTable::kLeadingTaps + j), tapsL[j], tapsR[j]);
+        outL = kernel.sinc->interpolate (tapsL, frac);
+        outR = kernel.sinc->interpolate (tapsR, frac);
+        return;
+    }
 
-    if (mode == RepitchMode::Cubic)
+    if (kernel.mode == RepitchMode::Cubic)
     {
-        return SampleData::interpolateCubic (sampleAt (base - 1),
-                                             sampleAt (base),
-                                             sampleAt (base + 1),
-                                             sampleAt (base + 2),
-                                             frac);
+        float l[4], r[4];
+        for (int j = 0; j < 4; ++j)
+            source.readFrame (mapFrame (base - 1 + j), l[j], r[j]);
+        outL = SampleData::interpolateCubic (l[0], l[1], l[2], l[3], frac);
+        outR = SampleData::interpolateCubic (r[0], r[1], r[2], r[3], frac);
+        return;
     }
 
-    const float s0 = sampleAt (base);
-    const float s1 = sampleAt (base + 1);
-    return s0 + (s1 - s0) * frac;
+    float l0, r0, l1, r1;
+    source.readFrame (mapFrame (base), l0, r0);
+    source.readFrame (mapFrame (base + 1), l1, r1);
+    outL = l0 + (l1 - l0) * frac;
+    outR = r0 + (r1 - r0) * frac;
 }
 
 static int wrapLoopFrame (int frame, int start, int end)
@@ -261,48 +350,60 @@ static int reflectPingPongFrame (int frame, int start, int end)
     return juce::roundToInt (reflectPingPongPosition ((double) frame, start, end));
 }
 
-static float readRepitchClampedSample (const SampleData& sample, double pos,
-                                       int channel, RepitchMode mode)
+static void readRepitchClampedFrame (const RepitchSource& source, double pos,
+                                     const RepitchKernel& kernel, float& outL, float& outR)
 {
-    const int maxFrame = sample.getNumFrames() - 1;
+    const int maxFrame = source.numFrames - 1;
     if (maxFrame < 0)
-        return 0.0f;
+    {
+        outL = outR = 0.0f;
+        return;
+    }
 
-    return readMappedRepitchSample (sample, pos, channel, mode,
-                                    [maxFrame] (int frame)
-                                    {
-                                        return juce::jlimit (0, maxFrame, frame);
-                                    });
+    readMappedRepitchFrame (source, pos, kernel,
+                            [maxFrame] (int frame)
+                            {
+                                return juce::jlimit (0, maxFrame, frame);
+                            },
+                            outL, outR);
 }
 
-static float readRepitchBoundedSliceSample (const SampleData& sample, double pos,
-                                            int channel, int start, int end,
-                                            RepitchMode mode)
+static void readRepitchBoundedSliceFrame (const RepitchSource& source, double pos,
+                                          int start, int end, const RepitchKernel& kernel,
+                                          float& outL, float& outR)
 {
     const int sliceLen = end - start;
     if (sliceLen <= 0)
-        return 0.0f;
+    {
+        outL = outR = 0.0f;
+        return;
+    }
 
-    return readMappedRepitchSample (sample, pos, channel, mode,
-                                    [start, end] (int frame)
-                                    {
-                                        return juce::jlimit (start, end - 1, frame);
-                                    });
+    readMappedRepitchFrame (source, pos, kernel,
+                            [start, end] (int frame)
+                            {
+                                return juce::jlimit (start, end - 1, frame);
+                            },
+                            outL, outR);
 }
 
-static float readRepitchWrappedLoopSample (const SampleData& sample, double pos,
-                                           int channel, int start, int end,
-                                           RepitchMode mode)
+static void readRepitchWrappedLoopFrame (const RepitchSource& source, double pos,
+                                         int start, int end, const RepitchKernel& kernel,
+                                         float& outL, float& outR)
 {
     const int loopLen = end - start;
     if (loopLen <= 0)
-        return 0.0f;
+    {
+        outL = outR = 0.0f;
+        return;
+    }
 
-    return readMappedRepitchSample (sample, pos, channel, mode,
-                                    [start, end] (int frame)
-                                    {
-                                        return wrapLoopFrame (frame, start, end);
-                                    });
+    readMappedRepitchFrame (source, pos, kernel,
+                            [start, end] (int frame)
+                            {
+                                return wrapLoopFrame (frame, start, end);
+                            },
+                            outL, outR);
 }
 
 // Reads a sample from the virtual looped source at an arbitrary position.
@@ -325,24 +426,29 @@ static float readExactLoopSample (const Voice& v, const SampleData& sample,
     return readClampedSample (sample, pos, channel);
 }
 
-static float readRepitchExactLoopSample (const Voice& v, const SampleData& sample,
-                                         double pos, int channel)
+static void readRepitchExactLoopFrame (const Voice& v, const RepitchSource& source,
+                                       double pos, float& outL, float& outR)
 {
-    const auto mode = getActiveRepitchMode (v.repitchMode);
+    const auto kernel = getRepitchKernel (v);
 
     if (v.pingPong && v.inLoopRegion)
     {
-        return readMappedRepitchSample (sample, pos, channel, mode,
-                                        [&v] (int frame)
-                                        {
-                                            return reflectPingPongFrame (frame, v.loopStartSample, v.loopEndSample);
-                                        });
+        readMappedRepitchFrame (source, pos, kernel,
+                                [&v] (int frame)
+                                {
+                                    return reflectPingPongFrame (frame, v.loopStartSample, v.loopEndSample);
+                                },
+                                outL, outR);
+        return;
     }
 
     if (v.looping && v.inLoopRegion)
-        return readRepitchWrappedLoopSample (sample, pos, channel, v.loopStartSample, v.loopEndSample, mode);
+    {
+        readRepitchWrappedLoopFrame (source, pos, v.loopStartSample, v.loopEndSample, kernel, outL, outR);
+        return;
+    }
 
-    return readRepitchClampedSample (sample, pos, channel, mode);
+    readRepitchClampedFrame (source, pos, kernel, outL, outR);
 }
 
 // --- Crossfade helpers ---
@@ -426,18 +532,19 @@ static float readCrossfadeMainSample (const Voice& v, const SampleData& sample,
     return readExactLoopSample (v, sample, pos, channel);
 }
 
-static float readRepitchCrossfadeMainSample (const Voice& v, const SampleData& sample,
-                                             double pos, int channel)
+static void readRepitchCrossfadeMainFrame (const Voice& v, const RepitchSource& source,
+                                           double pos, float& outL, float& outR)
 {
-    const auto mode = getActiveRepitchMode (v.repitchMode);
+    const auto kernel = getRepitchKernel (v);
 
     if (v.looping || v.pingPong)
     {
-        return readRepitchBoundedSliceSample (sample, mapCrossfadePosition (v, pos),
-                                              channel, v.loopStartSample, v.loopEndSample, mode);
+        readRepitchBoundedSliceFrame (source, mapCrossfadePosition (v, pos),
+                                      v.loopStartSample, v.loopEndSample, kernel, outL, outR);
+        return;
     }
 
-    return readRepitchExactLoopSample (v, sample, pos, channel);
+    readRepitchExactLoopFrame (v, source, pos, outL, outR);
 }
 
 // Reads a crossfaded sample at the given position. The secondary source depends on
@@ -464,26 +571,33 @@ static float readCrossfadedSample (const Voice& v, const SampleData& sample,
     return gainMain * mainSample + gainXfade * xfadeSample;
 }
 
-static float readRepitchCrossfadedSample (const Voice& v, const SampleData& sample,
-                                          double pos, int channel, int direction)
+static void readRepitchCrossfadedFrame (const Voice& v, const RepitchSource& source,
+                                        double pos, int direction, float& outL, float& outR)
 {
     if (v.crossfadeLenSamples <= 0)
-        return readRepitchExactLoopSample (v, sample, pos, channel);
+    {
+        readRepitchExactLoopFrame (v, source, pos, outL, outR);
+        return;
+    }
 
     const int dist = distanceToBoundary (v, pos, direction);
     if (dist >= v.crossfadeLenSamples)
-        return readRepitchExactLoopSample (v, sample, pos, channel);
+    {
+        readRepitchExactLoopFrame (v, source, pos, outL, outR);
+        return;
+    }
 
     const float t = 1.0f - (float) dist / (float) v.crossfadeLenSamples;
     float gainMain, gainXfade;
     equalPowerGains (t, gainMain, gainXfade);
 
-    const auto mode = getActiveRepitchMode (v.repitchMode);
-    const float mainSample = readRepitchCrossfadeMainSample (v, sample, pos, channel);
-    const float xfadeSample = readRepitchClampedSample (sample, getCrossfadeSourcePos (v, dist, direction),
-                                                        channel, mode);
+    const auto kernel = getRepitchKernel (v);
+    float mainL, mainR, xfadeL, xfadeR;
+    readRepitchCrossfadeMainFrame (v, source, pos, mainL, mainR);
+    readRepitchClampedFrame (source, getCrossfadeSourcePos (v, dist, direction), kernel, xfadeL, xfadeR);
 
-    return gainMain * mainSample + gainXfade * xfadeSample;
+    outL = gainMain * mainL + gainXfade * xfadeL;
+    outR = gainMain * mainR + gainXfade * xfadeR;
 }
 
 // Computes the crossfade source position for UI cursor display.
@@ -647,31 +761,220 @@ static inline void processVoiceFilter (Voice& v, float sampleRate, float& inOutL
     inOutR = yR;
 }
 
+// --- Block render helpers ---
+
+// Number of repitch steps that can be rendered without hitting a loop/slice boundary,
+// a crossfade zone or a read that needs frame mapping. Positions p0..p[n] all stay in
+// the safe range; one step of slack absorbs accumulation error. Returns 0 if the voice
+// must take the per-sample path.
+static int getRepitchSteadyRunLength (const Voice& v, int bufferFrames, int maxRun)
+{
+    if (! (v.speed > 0.0) || (v.direction != 1 && v.direction != -1))
+        return 0;
+
+    const bool forward = v.direction > 0;
+    const bool isLooping = v.looping || v.pingPong;
+    const auto mode = getActiveRepitchMode (v.repitchMode);
+    const int leadingTaps  = mode == RepitchMode::Sinc ? SincTable::kLeadingTaps
+                           : mode == RepitchMode::Cubic ? 1 : 0;
+    const int trailingTaps = mode == RepitchMode::Sinc ? SincTable::kTrailingTaps
+                           : mode == RepitchMode::Cubic ? 2 : 1;
+
+    double lo = -std::numeric_limits<double>::max();
+    double hi = std::numeric_limits<double>::max();
+
+    // classifyBoundaryAction must keep returning continuePlayback
+    if (isLooping && ! v.inLoopRegion)
+    {
+        if (forward)
+            hi = (double) juce::jmin (v.loopEndSample, v.endSample) - 1.0;
+        else
+            lo = (double) juce::jmax (v.loopStartSample, v.startSample);
+    }
+    else
+    {
+        if (forward)
+            hi = (double) (isLooping ? v.loopEndSample : v.endSample) - 1.0;
+        else
+            lo = (double) (isLooping ? v.loopStartSample : v.startSample);
+    }
+
+    // Stay outside the crossfade zone of the approaching seam
+    if (v.crossfadeLenSamples > 0)
+    {
+        const int bStart = isLooping ? v.loopStartSample : v.startSample;
+        const int bEnd   = isLooping ? v.loopEndSample   : v.endSample;
+        if (forward)
+            hi = juce::jmin (hi, (double) (juce::jmax (bStart, bEnd - 1) - v.crossfadeLenSamples));
+        else
+            lo = juce::jmax (lo, (double) (bStart + v.crossfadeLenSamples));
+    }
+
+    // Every interpolation tap must map to itself (no clamping, wrapping or reflection)
+    int frameLo = 0;
+    int frameHi = bufferFrames - 1;
+    if (isLooping && v.inLoopRegion)
+    {
+        frameLo = juce::jmax (frameLo, v.loopStartSample);
+        frameHi = juce::jmin (frameHi, v.loopEndSample - 1);
+    }
+    lo = juce::jmax (lo, (double) (frameLo + leadingTaps));
+    hi = juce::jmin (hi, (double) (frameHi - trailingTaps));
+
+    const double p0 = v.position;
+    if (p0 < lo || p0 > hi)
+        return 0;
+
+    const double room = forward ? (hi - p0) : (p0 - lo);
+    const double steps = std::floor (room / v.speed) - 1.0;
+    if (steps < 1.0)
+        return 0;
+
+    return (int) juce::jmin ((double) maxRun, steps);
+}
+
+// Tight repitch read loop for a steady run. Matches readMappedRepitchFrame bit-for-bit
+// when every tap maps to itself, which getRepitchSteadyRunLength guarantees.
+static void readRepitchRun (Voice& v, const float* dataL, const float* dataR,
+                            float* outL, float* outR, int numSamples)
+{
+    const double step = v.speed * v.direction;
+    double pos = v.position;
+
+    const auto kernel = getRepitchKernel (v);
+
+    if (kernel.sinc != nullptr)
+    {
+        for (int k = 0; k < numSamples; ++k)
+        {
+            const double baseFloor = std::floor (pos);
+            const int base = (int) baseFloor;
+            const float frac = (float) (pos - baseFloor);
+            outL[k] = kernel.sinc->interpolate (dataL + base - SincTable::kLeadingTaps, frac);
+            outR[k] = kernel.sinc->interpolate (dataR + base - SincTable::kLeadingTaps, frac);
+            pos += step;
+        }
+    }
+    else if (kernel.mode == RepitchMode::Cubic)
+    {
+        for (int k = 0; k < numSamples; ++k)
+        {
+            const double baseFloor = std::floor (pos);
+            const int base = (int) baseFloor;
+            const float frac = (float) (pos - baseFloor);
+            outL[k] = SampleData::interpolateCubic (dataL[base - 1], dataL[base], dataL[base + 1], dataL[base + 2], frac);
+            outR[k] = SampleData::interpolateCubic (dataR[base - 1], dataR[base], dataR[base + 1], dataR[base + 2], frac);
+            pos += step;
+        }
+    }
+    else
+    {
+        for (int k = 0; k < numSamples; ++k)
+        {
+            const double baseFloor = std::floor (pos);
+            const int base = (int) baseFloor;
+            const float frac = (float) (pos - baseFloor);
+            outL[k] = dataL[base] + (dataL[base + 1] - dataL[base]) * frac;
+            outR[k] = dataR[base] + (dataR[base + 1] - dataR[base]) * frac;
+            pos += step;
+        }
+    }
+
+    v.position = pos;
+}
+
+// Frames beyond a run's position span that its window must cover: every kernel's
+// taps plus a frame of slack either side for position accumulation error.
+static constexpr int kCompactWindowReach = SincTable::kLeadingTaps + SincTable::kTrailingTaps + 4;
+
+// Steady run length for a compact-storage sample, capped so the frames it touches
+// fit in one conversion window.
+static int getCompactRepitchRunLength (const Voice& v, int bufferFrames, int maxRun)
+{
+    const double fit = std::floor ((double) (kCompactWindowFrames - kCompactWindowReach) / juce::jmax (v.speed, 1.0e-6));
+    const int cappedRun = (int) juce::jmin ((double) maxRun, fit - 1.0);
+    if (cappedRun <= 0)
+        return 0;
+
+    return getRepitchSteadyRunLength (v, bufferFrames, cappedRun);
+}
+
+// Converts the frames a steady run touches from compact storage to float with the
+// SIMD kernels, then renders the run from that window.
+static void readCompactRepitchRun (Voice& v, const CompactPcm& pcm,
+                                   float* outL, float* outR, int numSamples)
+{
+    const double endPos = v.position + v.speed * v.direction * numSamples;
+    const int lo = juce::jmax (0, (int) std::floor (juce::jmin (v.position, endPos)) - SincTable::kLeadingTaps - 1);
+    const int hi = juce::jmin (pcm.getNumFrames(),
+                               (int) std::floor (juce::jmax (v.position, endPos)) + SincTable::kTrailingTaps + 2);
+    const int count = juce::jlimit (0, kCompactWindowFrames, hi - lo);
+
+    float windowL[kCompactWindowFrames];
+    float windowR[kCompactWindowFrames];
+    pcm.read (0, lo, count, windowL);
+    pcm.read (1, lo, count, windowR);
+
+    // readRepitchRun indexes from the voice position, so run it in window coordinates.
+    v.position -= lo;
+    readRepitchRun (v, windowL, windowR, outL, outR, numSamples);
+    v.position += lo;
+}
+
+static void allocateStretchBuffers (Voice& v)
+{
+    v.stretchOutBufL.resize (kStretchBlockSize);
+    v.stretchOutBufR.resize (kStretchBlockSize);
+}
+
 VoicePool::VoicePool()
 {
+    SincTable::prewarm();
+
     for (auto& p : voicePositions)
         p.store (0.0f, std::memory_order_relaxed);
     for (auto& p : xfadeSourcePositions)
         p.store (0.0f, std::memory_order_relaxed);
 
     for (auto& v : voices)
-    {
-        v.stretchInBufL.resize (kMaxStretchInputSamples);
-        v.stretchInBufR.resize (kMaxStretchInputSamples);
-        v.stretchOutBufL.resize (kStretchBlockSize);
-        v.stretchOutBufR.resize (kStretchBlockSize);
-        v.bungeeInputBuf.resize ((size_t) kMaxBungeeInputFrames * 2);
-        v.bungeeOutBufL.resize (kMaxBungeeOutputFrames);
-        v.bungeeOutBufR.resize (kMaxBungeeOutputFrames);
-    }
+        allocateStretchBuffers (v);
 }
 
-void VoicePool::prepareToPlay (double sr, int maxBlockSize)
+void VoicePool::prepareToPlay (double sr, int /*maxBlockSize*/)
 {
     setSampleRate (sr);
-    const int scratchSize = juce::jmax (1, maxBlockSize);
-    scratchL.resize ((size_t) scratchSize, 0.0f);
-    scratchR.resize ((size_t) scratchSize, 0.0f);
+
+    if (stretcherPool.getPreparedSampleRate() == sr)
+        return;
+
+    // Rebuilding invalidates every borrowed instance, so drop them (and silence
+    // any voice still depending on one) before the old pool is destroyed.
+    for (auto& v : voices)
+    {
+        if (v.stretchActive || v.bungeeActive)
+            v.active = false;
+
+        v.stretchActive = false;
+        v.bungeeActive = false;
+        v.stretcher = nullptr;
+        v.bungeeStretcher = nullptr;
+
+        // Renders are keyed by rate, so frozen voices stop with the old cache
+        if (v.frozen != nullptr)
+            v.active = false;
+        StretchFreezeCache::releaseVoiceRef (v.frozen);
+    }
+
+    warmStarts.stop();
+    freezeCache.stop();
+    stretcherPool.prepare (sr, numStretchVoices (requestedMaxActive), kMaxVoices,
+                           StretchWarmStartCache::kNumEntries);
+    scratch.allocate (kMaxStretchInputSamples, stretcherPool.getMaxBungeeInputFrames());
+    requestedWarmStarts.fill ({});
+    requestedFreezes.fill ({});
+    seenFreezes.fill ({});
+    warmStarts.prepare (stretcherPool);
+    freezeCache.start();
 }
 
 void VoicePool::setSampleRate (double sr)
@@ -706,9 +1009,23 @@ int VoicePool::allocate()
     return best;
 }
 
+int VoicePool::numStretchVoices (int playableVoices)
+{
+    // The preview voice can stretch alongside every playable one.
+    return juce::jmin (kMaxVoices, playableVoices + 1);
+}
+
 void VoicePool::setMaxActiveVoices (int n)
 {
-    n = juce::jlimit (1, kMaxVoices - 1, n);
+    requestedMaxActive = juce::jlimit (1, kMaxVoices - 1, n);
+    stretcherPool.requestVoices (numStretchVoices (requestedMaxActive));
+
+    // Extra voices wait until the pool has built their stretchers, so a note-on
+    // never has to fall back to plain repitch. Lowering takes effect at once.
+    n = requestedMaxActive;
+    if (stretcherPool.getPreparedSampleRate() > 0.0)
+        n = juce::jlimit (1, n, stretcherPool.getNumVoicesReady() - 1);
+
     if (n < maxActive)
     {
         // Kill voices beyond new limit (preview is permanently reserved).
@@ -731,6 +1048,7 @@ void VoicePool::initPreviewVoiceCommon (Voice& v,
                                         bool looping,
                                         float velocity)
 {
+    StretchFreezeCache::releaseVoiceRef (v.frozen);
     v.active        = true;
     v.sliceIdx      = -1;
     v.position      = (double) playheadSample;
@@ -841,38 +1159,182 @@ void VoicePool::initStretcher (Voice& v, float pitchSemis, double sr,
                                float tonalityHz, float formantSemis, bool formantComp,
                                const SampleData& sample)
 {
-    int blockSize = std::max (256, (int)(sr * 0.023));   // ~1024 @ 44.1k (~23ms)
-    int interval  = std::max (64,  (int)(sr * 0.006));   // ~256 @ 44.1k (~6ms)
+    // A retriggered voice keeps its pooled instance; reset() clears the previous
+    // note without re-running configure()'s allocations.
+    if (v.stretcher == nullptr)
+        v.stretcher = stretcherPool.acquireSignalsmith();
+
+    if (v.stretcher == nullptr)
+    {
+        // Pool not prepared yet: fall back to plain repitch rather than allocate here.
+        v.stretchActive = false;
+        v.speed = std::pow (2.0, (double) pitchSemis / 12.0) * (double) v.stretchTimeRatio;
+        return;
+    }
 
-    if (! v.stretcher)
-        v.stretcher = std::make_shared<signalsmith::stretch::SignalsmithStretch<float, void>>();
-    v.stretcher->configure (2, blockSize, interval, false);
+    v.stretcher->reset();
 
     float tonalityLimit = (tonalityHz > 0.0f && sr > 0.0) ? (float)(tonalityHz / sr) : 0.0f;
     v.stretcher->setTransposeSemitones (pitchSemis, tonalityLimit);
 
-    if (formantSemis != 0.0f || formantComp)
-        v.stretcher->setFormantSemitones (formantSemis, formantComp);
+    // Always applied so a reused instance never inherits the previous note's formant shift
+    v.stretcher->setFormantSemitones (formantSemis, formantComp);
 
     v.stretchOutReadPos = 0;
     v.stretchOutAvail = 0;
 
     // Pre-roll from current stretchSrcPos via shared reseek helper
-    reseekStretcher (v, sample, true);
+    reseekStretcher (v, scratch, sample, true);
 }
 
-void VoicePool::initBungee (Voice& v, float pitchSemis, double sr, int grainMode)
+void VoicePool::initBungee (Voice& v, float pitchSemis, double /*sr*/, int grainMode)
 {
-    Bungee::SampleRates rates;
-    rates.input  = (int) sr;
-    rates.output = (int) sr;
+    const int hopAdj = StretcherPool::clampBungeeHopAdjust (grainMode);
 
-    int hopAdj = juce::jlimit (-1, 0, grainMode);
-    v.bungeeStretcher = std::make_shared<Bungee::Stretcher<Bungee::Basic>> (rates, 2, hopAdj);
+    if (v.bungeeStretcher != nullptr && v.bungeeHopAdjust != hopAdj)
+    {
+        stretcherPool.releaseBungee (v.bungeeStretcher, v.bungeeHopAdjust);
+        v.bungeeStretcher = nullptr;
+    }
+
+    // A reused instance is cleared by the reset/preroll request fillBungeeBlock
+    // issues once the output counters below are zero.
+    if (v.bungeeStretcher == nullptr)
+    {
+        v.bungeeStretcher = stretcherPool.acquireBungee (hopAdj);
+        v.bungeeHopAdjust = hopAdj;
+    }
 
     v.bungeePitch = std::pow (2.0, (double) pitchSemis / 12.0);
     v.bungeeOutReadPos = 0;
     v.bungeeOutAvail = 0;
+    v.bungeeResetNeeded = true;
+
+    if (v.bungeeStretcher == nullptr)
+    {
+        v.bungeeActive = false;
+        v.speed = v.bungeePitch * std::abs (v.bungeeSpeed);
+    }
+}
+
+namespace
+{
+struct SliceStretchSetup
+{
+    int   algorithm   = 0;
+    bool  reverse     = false;
+    bool  stretchOn   = false;
+    float sliceBpm    = 120.0f;
+    float pitch       = 0.0f;   // semitones, including cents and range transpose
+    float tonality    = 0.0f;
+    float formant     = 0.0f;
+    bool  formantComp = false;
+    int   grainMode   = 0;
+    int   loopMode    = 0;
+    bool  releaseTail = false;
+};
+}
+
+// Shared by startVoice() and the warm-start refresh so both key on identical values.
+static SliceStretchSetup resolveSliceStretchSetup (const VoiceStartParams& p,
+                                                   const SliceManager& sm, int sliceIdx)
+{
+    const auto& s = sm.getSlice (sliceIdx);
+    SliceStretchSetup setup;
+
+    setup.reverse = sm.resolveParam (sliceIdx, kLockReverse,
+                                     s.reverse ? 1.0f : 0.0f,
+                                     p.globalReverse ? 1.0f : 0.0f) > 0.5f;
+    setup.algorithm = (int) sm.resolveParam (sliceIdx, kLockAlgorithm, (float) s.algorithm, (float) p.globalAlgorithm);
+    setup.sliceBpm = sm.resolveParam (sliceIdx, kLockBpm, s.bpm, p.globalBpm);
+
+    const float pitchSt = sm.resolveParam (sliceIdx, kLockPitch,       s.pitchSemitones, p.globalPitch);
+    const float cents   = sm.resolveParam (sliceIdx, kLockCentsDetune, s.centsDetune,    p.globalCentsDetune);
+    setup.pitch = pitchSt + cents / 100.0f;
+
+    setup.stretchOn = sm.resolveParam (sliceIdx, kLockStretch,
+                                       s.stretchEnabled ? 1.0f : 0.0f,
+                                       p.globalStretch ? 1.0f : 0.0f) > 0.5f;
+
+    // Range transpose: chromatic offset from slice root note.
+    // Ignored for Repitch+stretch where pitch is tied to BPM-locked speed.
+    const float rangeTranspose = (float) (p.note - p.sliceRootNote);
+    const bool repitchWithStretch = (setup.algorithm == 0 && setup.stretchOn
+                                     && p.dawBpm > 0.0f && setup.sliceBpm > 0.0f);
+    if (! repitchWithStretch)
+        setup.pitch += rangeTranspose;
+
+    setup.tonality = sm.resolveParam (sliceIdx, kLockTonality, s.tonalityHz,       p.globalTonality);
+    setup.formant  = sm.resolveParam (sliceIdx, kLockFormant,  s.formantSemitones, p.globalFormant);
+    setup.formantComp = sm.resolveParam (sliceIdx, kLockFormantComp,
+                                         s.formantComp ? 1.0f : 0.0f,
+                                         p.globalFormantComp ? 1.0f : 0.0f) > 0.5f;
+    setup.grainMode = (int) sm.resolveParam (sliceIdx, kLockGrainMode,
+                                             (float) s.grainMode, (float) p.globalGrainMode);
+    setup.loopMode = (int) sm.resolveParam (sliceIdx, kLockLoop, (float) s.loopMode, (float) p.globalLoopMode);
+    setup.releaseTail = sm.resolveParam (sliceIdx, kLockReleaseTail,
+                                         s.releaseTail ? 1.0f : 0.0f,
+                                         p.globalReleaseTail ? 1.0f : 0.0f) > 0.5f;
+    return setup;
+}
+
+// The seek a Signalsmith voice for this slice would run on note-on, or an empty
+// key (sampleGeneration 0) when the slice does not start a Signalsmith voice.
+static StretchWarmStartKey makeStretchWarmStartKey (const SliceStretchSetup& setup, const VoiceStartParams& p,
+                                                    const Slice& s, const SampleData& sample, double sr)
+{
+    StretchWarmStartKey key;
+    if (setup.algorithm != 1 || sr <= 0.0)
+        return key;
+
+    const bool timeStretch = setup.stretchOn && p.dawBpm > 0.0f && setup.sliceBpm > 0.0f;
+
+    key.sampleGeneration = sample.getActiveGeneration();
+    key.startFrame    = setup.reverse ? (s.endSample - 1) : s.startSample;
+    key.activeLength  = s.endSample - s.startSample;
+    key.direction     = setup.reverse ? -1 : 1;
+    key.timeRatio     = timeStretch ? p.dawBpm / setup.sliceBpm : 1.0f;
+    key.pitchSemis    = setup.pitch;
+    key.tonalityLimit = setup.tonality > 0.0f ? (float) (setup.tonality / sr) : 0.0f;
+    key.formantSemis  = setup.formant;
+    key.formantComp   = setup.formantComp;
+    return key;
+}
+
+// A freeze render only stands in for voices that play straight through once:
+// loops and release tails keep reading the source past the rendered span.
+// Each slice has one render, at its root note; range-transposed notes play live.
+static StretchFreezeKey makeStretchFreezeKey (const SliceStretchSetup& setup, const VoiceStartParams& p,
+                                              const Slice& s, const SampleData& sample, double sr)
+{
+    StretchFreezeKey key;
+    if (! p.freezeStretch || (setup.algorithm != 1 && setup.algorithm != 2)
+        || setup.loopMode != 0 || setup.releaseTail || sr <= 0.0
+        || s.endSample <= s.startSample || p.note != p.sliceRootNote)
+        return key;
+
+    const bool timeStretch = setup.stretchOn && p.dawBpm > 0.0f && setup.sliceBpm > 0.0f;
+
+    key.sampleGeneration = sample.getActiveGeneration();
+    key.startSample  = s.startSample;
+    key.endSample    = s.endSample;
+    key.algorithm    = setup.algorithm;
+    key.reverse      = setup.reverse;
+    key.timeRatio    = timeStretch ? p.dawBpm / setup.sliceBpm : 1.0f;
+    key.pitchSemis   = setup.pitch;
+    key.sampleRate   = sr;
+
+    if (setup.algorithm == 1)
+    {
+        key.tonalityHz   = setup.tonality;
+        key.formantSemis = setup.formant;
+        key.formantComp  = setup.formantComp;
+    }
+    else
+    {
+        key.grainMode = setup.grainMode;
+    }
+    return key;
 }
 
 void VoicePool::startVoice (int voiceIdx, const VoiceStartParams& p,
@@ -882,6 +1344,7 @@ void VoicePool::startVoice (int voiceIdx, const VoiceStartParams& p,
     const int sliceIdx = p.sliceIdx;
     const auto& s = sm.getSlice (sliceIdx);
 
+    StretchFreezeCache::releaseVoiceRef (v.frozen);
     v.active    = true;
     v.sliceIdx  = sliceIdx;
     v.midiNote  = p.note;
@@ -903,47 +1366,28 @@ void VoicePool::startVoice (int voiceIdx, const VoiceStartParams& p,
     v.pingPong   = (resolvedLoopMode == 2);
     v.muteGroup  = (int) sm.resolveParam (sliceIdx, kLockMuteGroup, (float) s.muteGroup, (float) p.globalMuteGroup);
 
-    bool rev = sm.resolveParam (sliceIdx, kLockReverse,
-                                 s.reverse ? 1.0f : 0.0f,
-                                 p.globalReverse ? 1.0f : 0.0f) > 0.5f;
+    const auto setup = resolveSliceStretchSetup (p, sm, sliceIdx);
+    const bool rev = setup.reverse;
     v.direction = rev ? -1 : 1;
     v.position  = rev ? (s.endSample - 1) : s.startSample;
 
     v.outputBus = (int) sm.resolveParam (sliceIdx, kLockOutputBus, (float) s.outputBus, 0.0f);
 
-    int algo = (int) sm.resolveParam (sliceIdx, kLockAlgorithm, (float) s.algorithm, (float) p.globalAlgorithm);
+    const int algo = setup.algorithm;
     int repitchMode = (int) sm.resolveParam (sliceIdx, kLockRepitchMode,
                                              (float) s.repitchMode, (float) p.globalRepitchMode);
 
-    float sliceBpm = sm.resolveParam (sliceIdx, kLockBpm,   s.bpm,            p.globalBpm);
-    float pitchSt  = sm.resolveParam (sliceIdx, kLockPitch,       s.pitchSemitones, p.globalPitch);
-    float cents    = sm.resolveParam (sliceIdx, kLockCentsDetune, s.centsDetune,    p.globalCentsDetune);
-    float pitch    = pitchSt + cents / 100.0f;
-
-    bool stretchOn = sm.resolveParam (sliceIdx, kLockStretch,
-                                       s.stretchEnabled ? 1.0f : 0.0f,
-                                       p.globalStretch ? 1.0f : 0.0f) > 0.5f;
-
-    // Range transpose: chromatic offset from slice root note.
-    // Ignored for Repitch+stretch where pitch is tied to BPM-locked speed.
-    const float rangeTranspose = (float) (p.note - p.sliceRootNote);
-    const bool repitchWithStretch = (algo == 0 && stretchOn
-                                     && p.dawBpm > 0.0f && sliceBpm > 0.0f);
-    if (! repitchWithStretch)
-        pitch += rangeTranspose;
-
+    const float sliceBpm = setup.sliceBpm;
+    const float pitch    = setup.pitch;
+    const bool stretchOn = setup.stretchOn;
     float pitchRatio = std::pow (2.0f, pitch / 12.0f);
 
-    float tonality = sm.resolveParam (sliceIdx, kLockTonality,    s.tonalityHz,       p.globalTonality);
-    float formant  = sm.resolveParam (sliceIdx, kLockFormant,     s.formantSemitones, p.globalFormant);
-    bool fComp     = sm.resolveParam (sliceIdx, kLockFormantComp,
-                                       s.formantComp ? 1.0f : 0.0f,
-                                       p.globalFormantComp ? 1.0f : 0.0f) > 0.5f;
+    const float tonality = setup.tonality;
+    const float formant  = setup.formant;
+    const bool fComp     = setup.formantComp;
 
-    int grainMode = (int) sm.resolveParam (sliceIdx, kLockGrainMode,
-                                           (float) s.grainMode, (float) p.globalGrainMode);
     // Convert grainMode index (0=Fast, 1=Normal, 2=Smooth) to log2 hop adjust (-1, 0, +1)
-    int hopAdj = grainMode - 1;
+    int hopAdj = setup.grainMode - 1;
 
     v.volume = dbToLinear (sm.resolveParam (sliceIdx, kLockVolume, s.volume, p.globalVolume));
     v.repitchMode = juce::jlimit (0, 2, repitchMode);
@@ -1041,6 +1485,9 @@ void VoicePool::startVoice (int voiceIdx, const VoiceStartParams& p,
     v.bungeeActive   = false;
     v.bungeeResetNeeded = false;
 
+    if (p.freezeStretch && startFrozenVoice (v, sliceIdx, makeStretchFreezeKey (setup, p, s, sample, sampleRate)))
+        return;
+
     if (stretchOn && p.dawBpm > 0.0f && sliceBpm > 0.0f)
     {
         float speedRatio = p.dawBpm / sliceBpm;
@@ -1069,7 +1516,8 @@ void VoicePool::startVoice (int voiceIdx, const VoiceStartParams& p,
             v.stretchPitchSemis = pitch;
             v.stretchSrcPos = rev ? (s.endSample - 1) : s.startSample;
 
-            initStretcher (v, pitch, sampleRate, tonality, formant, fComp, sample);
+            startSliceStretcher (v, sliceIdx, makeStretchWarmStartKey (setup, p, s, sample, sampleRate),
+                                 tonality, formant, fComp, sample);
         }
     }
     else
@@ -1083,7 +1531,8 @@ void VoicePool::startVoice (int voiceIdx, const VoiceStartParams& p,
             v.stretchPitchSemis = pitch;
             v.stretchSrcPos = rev ? (s.endSample - 1) : s.startSample;
 
-            initStretcher (v, pitch, sampleRate, tonality, formant, fComp, sample);
+            startSliceStretcher (v, sliceIdx, makeStretchWarmStartKey (setup, p, s, sample, sampleRate),
+                                 tonality, formant, fComp, sample);
         }
         else if (algo == 2)
         {
@@ -1103,6 +1552,139 @@ void VoicePool::startVoice (int voiceIdx, const VoiceStartParams& p,
     }
 }
 
+void VoicePool::startSliceStretcher (Voice& v, int sliceIdx, const StretchWarmStartKey& key,
+                                     float tonalityHz, float formantSemis, bool formantComp,
+                                     const SampleData& sample)
+{
+    if (key.sampleGeneration != 0)
+    {
+        if (auto* entry = warmStarts.take (sliceIdx, key, sample))
+        {
+            if (v.stretcher == nullptr)
+                v.stretcher = stretcherPool.acquireSignalsmith();
+
+            if (v.stretcher != nullptr)
+            {
+                // The primed instance has already run this note's seek; the voice's
+                // previous instance goes back to be primed for the next trigger.
+                std::swap (v.stretcher, entry->stretcher);
+                v.stretchSrcPos += v.direction * entry->seekLength;
+                v.stretchOutReadPos = 0;
+                v.stretchOutAvail = 0;
+                warmStarts.giveBack (sliceIdx, entry, sample);
+                return;
+            }
+
+            warmStarts.giveBack (sliceIdx, entry, sample);
+        }
+        else
+        {
+            warmStarts.request (sliceIdx, key, sample, true);
+        }
+    }
+
+    initStretcher (v, v.stretchPitchSemis, sampleRate, tonalityHz, formantSemis, formantComp, sample);
+}
+
+bool VoicePool::startFrozenVoice (Voice& v, int sliceIdx, const StretchFreezeKey& key)
+{
+    if (key.sampleGeneration == 0)
+        return false;
+
+    // Renders are only requested by refreshStretchCaches() once a key holds still,
+    // so a miss here (tempo moving, render evicted) just plays live.
+    auto* frozen = freezeCache.acquire (sliceIdx, key);
+    if (frozen == nullptr)
+        return false;
+
+    // Play the render forward at unity speed; pitch, tempo and direction are baked in.
+    v.frozen = frozen;
+    v.speed = 1.0;
+    v.direction = 1;
+    v.position = 0.0;
+    v.startSample = 0;
+    v.endSample = frozen->numFrames;
+    v.loopStartSample = 0;
+    v.loopEndSample = frozen->numFrames;
+    v.inLoopRegion = true;
+    v.crossfadeLenSamples = 0;
+    v.bufferEnd = frozen->numFrames;
+    v.repitchMode = (int) RepitchMode::Linear;   // integer positions: an exact copy
+    return true;
+}
+
+bool VoicePool::isStretchCacheRefreshDue (int numSamples)
+{
+    stretchCacheRefreshCountdown -= numSamples;
+    if (stretchCacheRefreshCountdown > 0)
+        return false;
+
+    stretchCacheRefreshCountdown = juce::jmax (1, (int) (sampleRate * kStretchCacheRefreshSec));
+    return true;
+}
+
+void VoicePool::refreshStretchCaches (const VoiceStartParams& base, const SliceManager& sm,
+                                      const SampleData& sample)
+{
+    if (freezeWasEnabled && ! base.freezeStretch)
+    {
+        freezeCache.retireAll();
+        requestedFreezes.fill ({});
+        seenFreezes.fill ({});
+    }
+    freezeWasEnabled = base.freezeStretch;
+
+    if (! sample.isLoaded())
+        return;
+
+    bool needFreezeBudget = false;
+    const int numSlices = sm.getNumSlices();
+    for (int i = 0; i < numSlices; ++i)
+    {
+        const auto& s = sm.getSlice (i);
+        if (! s.active)
+            continue;
+
+        auto p = base;
+        p.sliceIdx = i;
+        p.note = s.midiNote;
+        p.sliceRootNote = s.sliceRootNote;
+
+        const auto setup = resolveSliceStretchSetup (p, sm, i);
+
+        if (freezeCache.takeRejected (i))
+        {
+            requestedFreezes[(size_t) i] = {};
+            needFreezeBudget = true;
+        }
+
+        // Renders are keyed at the root note. A key is only rendered once it has held
+        // for two passes, so tempo automation does not re-render every slice.
+        auto rootP = p;
+        rootP.note = s.sliceRootNote;
+        const auto freezeKey = makeStretchFreezeKey (p.note == rootP.note ? setup : resolveSliceStretchSetup (rootP, sm, i),
+                                                     rootP, s, sample, sampleRate);
+        const bool freezeKeyHeld = freezeKey == seenFreezes[(size_t) i];
+        seenFreezes[(size_t) i] = freezeKey;
+        if (freezeKey.sampleGeneration != 0 && freezeKeyHeld)
+        {
+            if (! (freezeKey == requestedFreezes[(size_t) i])
+                && freezeCache.request (i, freezeKey, sample))
+                requestedFreezes[(size_t) i] = freezeKey;
+        }
+
+        const auto key = makeStretchWarmStartKey (setup, p, s, sample, sampleRate);
+        if (key.sampleGeneration == 0 || key == requestedWarmStarts[(size_t) i])
+            continue;
+
+        if (warmStarts.request (i, key, sample, false))
+            requestedWarmStarts[(size_t) i] = key;
+    }
+
+    if (needFreezeBudget)
+        freezeCache.evictLeastRecent();
+}
+
 void VoicePool::releaseNote (int note)
 {
     for (int i = 0; i < maxActive; ++i)
@@ -1164,7 +1746,7 @@ void VoicePool::muteGroup (int group, int exceptVoice)
 
 // Reseek the Signalsmith stretcher from the current stretchSrcPos/direction.
 // Extracted from initStretcher() so it can also be called at loop/ping-pong seams.
-static void reseekStretcher (Voice& v, const SampleData& sample, bool consumeSource)
+static void reseekStretcher (Voice& v, StretchScratch& scratch, const SampleData& sample, bool consumeSource)
 {
     if (! v.stretcher || ! sample.isLoaded())
         return;
@@ -1174,7 +1756,7 @@ static void reseekStretcher (Voice& v, const SampleData& sample, bool consumeSou
     const int activeLen = v.inLoopRegion ? (v.loopEndSample - v.loopStartSample)
                                          : (v.endSample - v.startSample);
     seekLen = std::min (seekLen, activeLen);
-    seekLen = juce::jlimit (0, (int) v.stretchInBufL.size(), seekLen);
+    seekLen = juce::jlimit (0, (int) scratch.stretchInL.size(), seekLen);
 
     if (seekLen > 0 && sample.getNumFrames() > 0)
     {
@@ -1183,10 +1765,10 @@ static void reseekStretcher (Voice& v, const SampleData& sample, bool consumeSou
             double srcPos = (v.direction > 0)
                 ? v.stretchSrcPos + i
                 : v.stretchSrcPos - i;
-            v.stretchInBufL[(size_t) i] = readExactLoopSample (v, sample, srcPos, 0);
-            v.stretchInBufR[(size_t) i] = readExactLoopSample (v, sample, srcPos, 1);
+            scratch.stretchInL[(size_t) i] = readExactLoopSample (v, sample, srcPos, 0);
+            scratch.stretchInR[(size_t) i] = readExactLoopSample (v, sample, srcPos, 1);
         }
-        float* ptrs[2] = { v.stretchInBufL.data(), v.stretchInBufR.data() };
+        float* ptrs[2] = { scratch.stretchInL.data(), scratch.stretchInR.data() };
         v.stretcher->outputSeek (ptrs, seekLen);
         if (consumeSource)
             v.stretchSrcPos += (v.direction > 0) ? seekLen : -seekLen;
@@ -1196,17 +1778,17 @@ static void reseekStretcher (Voice& v, const SampleData& sample, bool consumeSou
     v.stretchOutAvail = 0;
 }
 
-static void fillStretchBlock (Voice& v, const SampleData& sample)
+static void fillStretchBlock (Voice& v, StretchScratch& scratch, const SampleData& sample)
 {
     if (v.stretchResetNeeded)
     {
-        reseekStretcher (v, sample, false);
+        reseekStretcher (v, scratch, sample, false);
         v.stretchResetNeeded = false;
     }
 
     int inputSamples = (int) (kStretchBlockSize * v.stretchTimeRatio);
     if (inputSamples < 1) inputSamples = 1;
-    const int maxInput = std::min ((int) v.stretchInBufL.size(), (int) v.stretchInBufR.size());
+    const int maxInput = std::min ((int) scratch.stretchInL.size(), (int) scratch.stretchInR.size());
     if (maxInput <= 0)
         return;
     inputSamples = juce::jlimit (1, maxInput, inputSamples);
@@ -1214,8 +1796,8 @@ static void fillStretchBlock (Voice& v, const SampleData& sample)
     for (int i = 0; i < inputSamples; ++i)
     {
         // Read from virtual looped source (with optional crossfade at loop boundaries)
-        v.stretchInBufL[(size_t) i] = readCrossfadedSample (v, sample, v.stretchSrcPos, 0, v.direction);
-        v.stretchInBufR[(size_t) i] = readCrossfadedSample (v, sample, v.stretchSrcPos, 1, v.direction);
+        scratch.stretchInL[(size_t) i] = readCrossfadedSample (v, sample, v.stretchSrcPos, 0, v.direction);
+        scratch.stretchInR[(size_t) i] = readCrossfadedSample (v, sample, v.stretchSrcPos, 1, v.direction);
 
         // Advance source position (loop/ping-pong wrap handled by advanceStretchSrcPos)
         auto action = advanceStretchSrcPos (v);
@@ -1239,12 +1821,12 @@ static void fillStretchBlock (Voice& v, const SampleData& sample)
 
             case VoiceBoundaryAction::release:
             {
-                const float lastL = v.stretchInBufL[(size_t) i];
-                const float lastR = v.stretchInBufR[(size_t) i];
+                const float lastL = scratch.stretchInL[(size_t) i];
+                const float lastR = scratch.stretchInR[(size_t) i];
                 for (int j = i + 1; j < inputSamples; ++j)
                 {
-                    v.stretchInBufL[(size_t) j] = lastL;
-                    v.stretchInBufR[(size_t) j] = lastR;
+                    scratch.stretchInL[(size_t) j] = lastL;
+                    scratch.stretchInR[(size_t) j] = lastR;
                 }
                 v.stretchSrcPos = (v.direction > 0)
                     ? (double) v.endSample
@@ -1271,7 +1853,7 @@ static void fillStretchBlock (Voice& v, const SampleData& sample)
     const int outputSamples = std::min (kStretchBlockSize, outCapacity);
 
     // Process through Signalsmith
-    float* inPtrs[2]  = { v.stretchInBufL.data(), v.stretchInBufR.data() };
+    float* inPtrs[2]  = { scratch.stretchInL.data(), scratch.stretchInR.data() };
     float* outPtrs[2] = { v.stretchOutBufL.data(), v.stretchOutBufR.data() };
     v.stretcher->process (inPtrs, inputSamples, outPtrs, outputSamples);
 
@@ -1279,7 +1861,7 @@ static void fillStretchBlock (Voice& v, const SampleData& sample)
     v.stretchOutAvail = outputSamples;
 }
 
-static void fillBungeeBlock (Voice& v, const SampleData& sample)
+static void fillBungeeBlock (Voice& v, StretchScratch& scratch, const SampleData& sample)
 {
     if (! v.bungeeStretcher)
         return;
@@ -1303,8 +1885,7 @@ static void fillBungeeBlock (Voice& v, const SampleData& sample)
     Bungee::InputChunk inputChunk = stretcher.specifyGrain (request);
 
     int numFrames = inputChunk.end - inputChunk.begin;
-    const int maxIn = std::min (stretcher.maxInputFrameCount(),
-                                (int) (v.bungeeInputBuf.size() / 2));
+    const int maxIn = std::min (stretcher.maxInputFrameCount(), scratch.bungeeInFrames);
     if (maxIn <= 0 || numFrames <= 0)
     {
         v.bungeeOutReadPos = 0;
@@ -1329,8 +1910,8 @@ static void fillBungeeBlock (Voice& v, const SampleData& sample)
         for (int i = 0; i < numFrames; ++i)
         {
             double pos = inputChunk.begin + i;
-            v.bungeeInputBuf[(size_t) i]         = readCrossfadedSample (v, sample, pos, 0, bungeeDir);
-            v.bungeeInputBuf[(size_t)(maxIn + i)] = readCrossfadedSample (v, sample, pos, 1, bungeeDir);
+            scratch.bungeeIn[(size_t) i]          = readCrossfadedSample (v, sample, pos, 0, bungeeDir);
+            scratch.bungeeIn[(size_t)(maxIn + i)] = readCrossfadedSample (v, sample, pos, 1, bungeeDir);
         }
     }
     else
@@ -1347,8 +1928,8 @@ static void fillBungeeBlock (Voice& v, const SampleData& sample)
                 sL = sample.getInterpolatedSample (pos, 0);
                 sR = sample.getInterpolatedSample (pos, 1);
             }
-            v.bungeeInputBuf[(size_t) i]         = sL;
-            v.bungeeInputBuf[(size_t)(maxIn + i)] = sR;
+            scratch.bungeeIn[(size_t) i]          = sL;
+            scratch.bungeeIn[(size_t)(maxIn + i)] = sR;
         }
 
         if (inputChunk.begin < v.startSample)
@@ -1357,32 +1938,22 @@ static void fillBungeeBlock (Voice& v, const SampleData& sample)
             muteTail = inputChunk.end - effectiveEnd;
     }
 
-    stretcher.analyseGrain (v.bungeeInputBuf.data(), (intptr_t) maxIn, muteHead, muteTail);
+    stretcher.analyseGrain (scratch.bungeeIn.data(), (intptr_t) maxIn, muteHead, muteTail);
 
     Bungee::OutputChunk outputChunk;
     stretcher.synthesiseGrain (outputChunk);
 
-    int outFrames = outputChunk.frameCount;
-    if (outFrames > 0)
+    // The grain stays in the stretcher's own output buffer until the next
+    // synthesiseGrain(), which only runs once the voice has read all of it.
+    v.bungeeOutReadPos = 0;
+    if (outputChunk.frameCount > 0)
     {
-        const float* outData = outputChunk.data;
-        intptr_t stride = outputChunk.channelStride;
-        const int outCapacity = std::min ((int) v.bungeeOutBufL.size(),
-                                          (int) v.bungeeOutBufR.size());
-        const int framesToCopy = std::min (outFrames, outCapacity);
-
-        for (int i = 0; i < framesToCopy; ++i)
-        {
-            v.bungeeOutBufL[(size_t) i] = outData[i];
-            v.bungeeOutBufR[(size_t) i] = outData[stride + i];
-        }
-
-        v.bungeeOutReadPos = 0;
-        v.bungeeOutAvail = framesToCopy;
+        v.bungeeOutL = outputChunk.data;
+        v.bungeeOutR = outputChunk.data + outputChunk.channelStride;
+        v.bungeeOutAvail = outputChunk.frameCount;
     }
     else
     {
-        v.bungeeOutReadPos = 0;
         v.bungeeOutAvail = 0;
     }
 
@@ -1424,10 +1995,97 @@ static void fillBungeeBlock (Voice& v, const SampleData& sample)
     }
 }
 
-void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr*/,
-                                     float& outL, float& outR)
+bool VoicePool::renderFrozenStretch (const StretchFreezeKey& key, const SampleData& source,
+                                     std::vector<float>& outL, std::vector<float>& outR)
+{
+    outL.clear();
+    outR.clear();
+
+    if (key.sampleGeneration == 0 || ! source.isLoaded() || key.sampleRate <= 0.0
+        || key.startSample < 0 || key.endSample > source.getNumFrames()
+        || key.endSample <= key.startSample)
+        return false;
+
+    // A scratch voice set up the way startVoice() sets up a one-shot stretch voice,
+    // so the render matches what a live voice would have played sample for sample.
+    Voice v;
+    allocateStretchBuffers (v);
+    StretchScratch scratch;   // this worker's own; the pool's belongs to the audio thread
+    v.active = true;
+    v.startSample = key.startSample;
+    v.endSample = key.endSample;
+    v.loopStartSample = key.startSample;
+    v.loopEndSample = key.endSample;
+    v.inLoopRegion = true;
+    v.bufferEnd = source.getNumFrames();
+    v.direction = key.reverse ? -1 : 1;
+
+    const double startPos = key.reverse ? (double) (key.endSample - 1) : (double) key.startSample;
+    const auto maxFrames = (size_t) (StretchFreezeCache::kMaxRenderSeconds * key.sampleRate);
+
+    auto append = [&] (const float* bufL, const float* bufR, int numFrames)
+    {
+        outL.insert (outL.end(), bufL, bufL + numFrames);
+        outR.insert (outR.end(), bufR, bufR + numFrames);
+    };
+
+    if (key.algorithm == 2)
+    {
+        Bungee::SampleRates rates;
+        rates.input  = (int) key.sampleRate;
+        rates.output = (int) key.sampleRate;
+        StretcherPool::BungeeStretcher stretcher (rates, 2, StretcherPool::clampBungeeHopAdjust (key.grainMode - 1));
+        scratch.allocate (0, stretcher.maxInputFrameCount());
+        v.bungeeStretcher = &stretcher;
+        v.bungeeActive = true;
+        v.bungeeSpeed = key.reverse ? -(double) key.timeRatio : (double) key.timeRatio;
+        v.bungeeSrcPos = startPos;
+        v.bungeePitch = std::pow (2.0, (double) key.pitchSemis / 12.0);
+        v.bungeeResetNeeded = true;
+
+        while (classifyBoundaryAction (v, v.bungeeSrcPos, getPlaybackDirection (v.bungeeSpeed), true)
+                   == VoiceBoundaryAction::continuePlayback
+               && outL.size() < maxFrames && ! juce::Thread::currentThreadShouldExit())
+        {
+            fillBungeeBlock (v, scratch, source);
+            append (v.bungeeOutL, v.bungeeOutR, v.bungeeOutAvail);
+            v.bungeeOutReadPos = v.bungeeOutAvail;
+        }
+    }
+    else
+    {
+        StretcherPool::SignalsmithStretcher stretcher;
+        StretcherPool::configureSignalsmith (stretcher, key.sampleRate);
+        scratch.allocate (kMaxStretchInputSamples, 0);
+        stretcher.setTransposeSemitones (key.pitchSemis,
+                                         key.tonalityHz > 0.0f ? (float) (key.tonalityHz / key.sampleRate) : 0.0f);
+        stretcher.setFormantSemitones (key.formantSemis, key.formantComp);
+
+        v.stretcher = &stretcher;
+        v.stretchActive = true;
+        v.stretchTimeRatio = key.timeRatio;
+        v.stretchPitchSemis = key.pitchSemis;
+        v.stretchSrcPos = startPos;
+        reseekStretcher (v, scratch, source, true);
+
+        while (classifyBoundaryAction (v, v.stretchSrcPos, getPlaybackDirection ((double) v.direction), true)
+                   == VoiceBoundaryAction::continuePlayback
+               && outL.size() < maxFrames && ! juce::Thread::currentThreadShouldExit())
+        {
+            fillStretchBlock (v, scratch, source);
+            append (v.stretchOutBufL.data(), v.stretchOutBufR.data(), v.stretchOutAvail);
+            v.stretchOutReadPos = v.stretchOutAvail;
+        }
+    }
+
+    return ! outL.empty() && ! juce::Thread::currentThreadShouldExit();
+}
+
+void VoicePool::processVoiceSample (int i, const SampleData& sessionSample, const SampleData::FrameView& frames,
+                                     double /*sr*/, float& outL, float& outR)
 {
     auto& v = voices[i];
+    const auto& sample = getVoiceSource (v, sessionSample);
     outL = 0.0f;
     outR = 0.0f;
 
@@ -1457,7 +2115,7 @@ void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr
             if (v.looping || v.pingPong)
             {
                 // Loop/ping-pong: fillStretchBlock handles wrapping internally
-                fillStretchBlock (v, sample);
+                fillStretchBlock (v, scratch, sample);
             }
             else
             {
@@ -1465,7 +2123,7 @@ void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr
                 {
                     case VoiceBoundaryAction::releaseTail:
                         releaseVoiceIfNeeded (v);
-                        fillStretchBlock (v, sample);
+                        fillStretchBlock (v, scratch, sample);
                         break;
 
                     case VoiceBoundaryAction::release:
@@ -1475,7 +2133,7 @@ void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr
                     case VoiceBoundaryAction::continuePlayback:
                     case VoiceBoundaryAction::loopWrap:
                     case VoiceBoundaryAction::pingPongTurnaround:
-                        fillStretchBlock (v, sample);
+                        fillStretchBlock (v, scratch, sample);
                         break;
                 }
             }
@@ -1491,10 +2149,7 @@ void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr
             v.stretchOutReadPos++;
         }
 
-        voicePositions[i].store ((float) v.stretchSrcPos, std::memory_order_relaxed);
-        xfadeSourcePositions[i].store (
-            computeXfadeSourceForUI (v, v.stretchSrcPos, getPlaybackDirection ((double) v.direction)),
-            std::memory_order_relaxed);
+        publishVoicePosition (i);
     }
     else if (v.bungeeActive)
     {
@@ -1517,7 +2172,7 @@ void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr
             if (v.looping || v.pingPong)
             {
                 // Loop/ping-pong: fillBungeeBlock handles wrapping internally
-                fillBungeeBlock (v, sample);
+                fillBungeeBlock (v, scratch, sample);
             }
             else
             {
@@ -1525,7 +2180,7 @@ void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr
                 {
                     case VoiceBoundaryAction::releaseTail:
                         releaseVoiceIfNeeded (v);
-                        fillBungeeBlock (v, sample);
+                        fillBungeeBlock (v, scratch, sample);
                         break;
 
                     case VoiceBoundaryAction::release:
@@ -1535,7 +2190,7 @@ void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr
                     case VoiceBoundaryAction::continuePlayback:
                     case VoiceBoundaryAction::loopWrap:
                     case VoiceBoundaryAction::pingPongTurnaround:
-                        fillBungeeBlock (v, sample);
+                        fillBungeeBlock (v, scratch, sample);
                         break;
                 }
             }
@@ -1543,8 +2198,8 @@ void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr
 
         if (v.bungeeOutReadPos < v.bungeeOutAvail)
         {
-            voiceL = v.bungeeOutBufL[(size_t) v.bungeeOutReadPos];
-            voiceR = v.bungeeOutBufR[(size_t) v.bungeeOutReadPos];
+            voiceL = v.bungeeOutL[v.bungeeOutReadPos];
+            voiceR = v.bungeeOutR[v.bungeeOutReadPos];
 
             processVoiceFilter (v, (float) sampleRate, voiceL, voiceR);
             voiceL *= env * v.velocity * v.volume;
@@ -1552,17 +2207,7 @@ void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr
             v.bungeeOutReadPos++;
         }
 
-        // Wrap unbounded Bungee phase for UI cursor display only
-        if (v.looping && v.inLoopRegion)
-            voicePositions[i].store ((float) wrapLoopPosition (v.bungeeSrcPos, v.loopStartSample, v.loopEndSample), std::memory_order_relaxed);
-        else if (v.pingPong && v.inLoopRegion)
-            voicePositions[i].store ((float) reflectPingPongPosition (v.bungeeSrcPos, v.loopStartSample, v.loopEndSample), std::memory_order_relaxed);
-        else
-            voicePositions[i].store ((float) v.bungeeSrcPos, std::memory_order_relaxed);
-
-        xfadeSourcePositions[i].store (
-            computeXfadeSourceForUI (v, v.bungeeSrcPos, getPlaybackDirection (v.bungeeSpeed)),
-            std::memory_order_relaxed);
+        publishVoicePosition (i);
     }
     else
     {
@@ -1580,16 +2225,11 @@ void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr
         }
 
         // Linear interpolation (with optional crossfade at loop boundaries)
+        const auto source = makeRepitchSource (sample, frames);
         if (v.crossfadeLenSamples > 0)
-        {
-            voiceL = readRepitchCrossfadedSample (v, sample, v.position, 0, v.direction);
-            voiceR = readRepitchCrossfadedSample (v, sample, v.position, 1, v.direction);
-        }
+            readRepitchCrossfadedFrame (v, source, v.position, v.direction, voiceL, voiceR);
         else
-        {
-            voiceL = readRepitchExactLoopSample (v, sample, v.position, 0);
-            voiceR = readRepitchExactLoopSample (v, sample, v.position, 1);
-        }
+            readRepitchExactLoopFrame (v, source, v.position, voiceL, voiceR);
         processVoiceFilter (v, (float) sampleRate, voiceL, voiceR);
         voiceL *= env * v.velocity * v.volume;
         voiceR *= env * v.velocity * v.volume;
@@ -1638,14 +2278,189 @@ void VoicePool::processVoiceSample (int i, const SampleData& sample, double /*sr
         }
 
         v.position = newPos;
+        publishVoicePosition (i);
+    }
+
+    outL = voiceL;
+    outR = voiceR;
+}
+
+void VoicePool::publishVoicePosition (int i)
+{
+    const auto& v = voices[(size_t) i];
+
+    if (v.stretchActive)
+    {
+        voicePositions[i].store ((float) v.stretchSrcPos, std::memory_order_relaxed);
+        xfadeSourcePositions[i].store (
+            computeXfadeSourceForUI (v, v.stretchSrcPos, getPlaybackDirection ((double) v.direction)),
+            std::memory_order_relaxed);
+    }
+    else if (v.bungeeActive)
+    {
+        // Wrap unbounded Bungee phase for UI cursor display only
+        if (v.looping && v.inLoopRegion)
+            voicePositions[i].store ((float) wrapLoopPosition (v.bungeeSrcPos, v.loopStartSample, v.loopEndSample), std::memory_order_relaxed);
+        else if (v.pingPong && v.inLoopRegion)
+            voicePositions[i].store ((float) reflectPingPongPosition (v.bungeeSrcPos, v.loopStartSample, v.loopEndSample), std::memory_order_relaxed);
+        else
+            voicePositions[i].store ((float) v.bungeeSrcPos, std::memory_order_relaxed);
+
+        xfadeSourcePositions[i].store (
+            computeXfadeSourceForUI (v, v.bungeeSrcPos, getPlaybackDirection (v.bungeeSpeed)),
+            std::memory_order_relaxed);
+    }
+    else if (v.frozen != nullptr)
+    {
+        // Map the rendered position back onto the source slice for the cursor
+        voicePositions[i].store ((float) (v.frozen->sourceOrigin + v.position * v.frozen->sourceStep),
+                                 std::memory_order_relaxed);
+        xfadeSourcePositions[i].store (0.0f, std::memory_order_relaxed);
+    }
+    else
+    {
         voicePositions[i].store ((float) v.position, std::memory_order_relaxed);
         xfadeSourcePositions[i].store (
             computeXfadeSourceForUI (v, v.position, getPlaybackDirection ((double) v.direction)),
             std::memory_order_relaxed);
     }
+}
 
-    outL = voiceL;
-    outR = voiceR;
+void VoicePool::publishStreamHints (SampleStreamer& streamer) const
+{
+    static_assert (SampleStreamer::kMaxVoices == kMaxVoices);
+
+    for (int i = 0; i < kMaxVoices; ++i)
+    {
+        const auto& v = voices[(size_t) i];
+        if (! v.active || v.frozen != nullptr)
+        {
+            streamer.clearVoiceHint (i);
+            continue;
+        }
+
+        SampleStreamer::VoiceHint hint;
+        if (v.stretchActive)
+        {
+            hint.position = (int) v.stretchSrcPos;
+            hint.direction = v.direction;
+        }
+        else if (v.bungeeActive)
+        {
+            // Already wrapped into the loop for the cursor
+            hint.position = (int) voicePositions[(size_t) i].load (std::memory_order_relaxed);
+            hint.direction = v.bungeeSpeed >= 0.0 ? 1 : -1;
+        }
+        else
+        {
+            hint.position = (int) v.position;
+            hint.direction = v.direction;
+        }
+
+        hint.looping = v.looping;
+        hint.pingPong = v.pingPong;
+        hint.loopStart = v.loopStartSample;
+        hint.loopEnd = v.loopEndSample;
+        streamer.setVoiceHint (i, hint);
+    }
+}
+
+void VoicePool::renderVoiceBlock (int i, const SampleData& sessionSample,
+                                  float* destL, float* destR, int numSamples)
+{
+    auto& v = voices[(size_t) i];
+    const auto& sample = getVoiceSource (v, sessionSample);
+
+    const auto& buffer = sample.getBuffer();
+    const auto* compact = sample.getCompact();
+    const int bufferFrames = juce::jmin (sample.getNumFrames(),
+                                         compact != nullptr ? compact->getNumFrames() : buffer.getNumSamples());
+    const bool canReadDirect = buffer.getNumChannels() >= 2 && bufferFrames > 0 && sample.hasDirectBuffer();
+    const float* dataL = canReadDirect ? buffer.getReadPointer (0) : nullptr;
+    const float* dataR = canReadDirect ? buffer.getReadPointer (1) : nullptr;
+    const auto frames = sample.getFrameView();
+
+    float envRun[kVoiceRunSize];
+    float filterEnvRun[kVoiceRunSize];
+    float runL[kVoiceRunSize];
+    float runR[kVoiceRunSize];
+
+    int s = 0;
+    while (s < numSamples && v.active)
+    {
+        // Runs end before the next filter coefficient refresh so it sees the right env level
+        int maxRun = juce::jmin (numSamples - s, kVoiceRunSize);
+        if (v.filterEnabled)
+            maxRun = juce::jmin (maxRun, juce::jmax (1, v.filterCoeffCounter));
+
+        int run = 0;
+        if (v.stretchActive)
+            run = juce::jmin (maxRun, v.stretchOutAvail - v.stretchOutReadPos);
+        else if (v.bungeeActive)
+            run = juce::jmin (maxRun, v.bungeeOutAvail - v.bungeeOutReadPos);
+        else if (dataL != nullptr && dataR != nullptr)
+            run = getRepitchSteadyRunLength (v, bufferFrames, maxRun);
+        else if (compact != nullptr && bufferFrames > 0)
+            run = getCompactRepitchRunLength (v, bufferFrames, maxRun);
+
+        if (run <= 0)
+        {
+            // Boundaries, refills and crossfades go through the reference path
+            float vL = 0.0f, vR = 0.0f;
+            processVoiceSample (i, sample, frames, sampleRate, vL, vR);
+            if (destL) destL[s] += vL;
+            if (destR) destR[s] += vR;
+            ++s;
+            continue;
+        }
+
+        const int rendered = v.envelope.processBlock (envRun, run);
+        if (v.filterEnabled)
+            v.filterEnvelope.processBlock (filterEnvRun, rendered);
+
+        if (v.stretchActive)
+        {
+            std::copy_n (v.stretchOutBufL.data() + v.stretchOutReadPos, rendered, runL);
+            std::copy_n (v.stretchOutBufR.data() + v.stretchOutReadPos, rendered, runR);
+            v.stretchOutReadPos += rendered;
+        }
+        else if (v.bungeeActive)
+        {
+            std::copy_n (v.bungeeOutL + v.bungeeOutReadPos, rendered, runL);
+            std::copy_n (v.bungeeOutR + v.bungeeOutReadPos, rendered, runR);
+            v.bungeeOutReadPos += rendered;
+        }
+        else if (compact != nullptr)
+        {
+            readCompactRepitchRun (v, *compact, runL, runR, rendered);
+        }
+        else
+        {
+            readRepitchRun (v, dataL, dataR, runL, runR, rendered);
+        }
+
+        for (int k = 0; k < rendered; ++k)
+        {
+            processVoiceFilter (v, (float) sampleRate, runL[k], runR[k]);
+            const float gain = envRun[k] * v.velocity * v.volume;
+            if (destL) destL[s + k] += runL[k] * gain;
+            if (destR) destR[s + k] += runR[k] * gain;
+        }
+
+        if (rendered < run)
+        {
+            // Envelope finished inside the run
+            v.active = false;
+            voicePositions[i].store (0.0f, std::memory_order_relaxed);
+            xfadeSourcePositions[i].store (0.0f, std::memory_order_relaxed);
+            return;
+        }
+
+        s += run;
+    }
+
+    if (v.active)
+        publishVoicePosition (i);
 }
 
 void VoicePool::processSample (const SampleData& sample, double sr,
@@ -1657,7 +2472,7 @@ void VoicePool::processSample (const SampleData& sample, double sr,
     for (int i = 0; i < maxActive; ++i)
     {
         float vL = 0.0f, vR = 0.0f;
-        processVoiceSample (i, sample, sr, vL, vR);
+        processVoiceSample (i, sample, getVoiceSource (voices[(size_t) i], sample).getFrameView(), sr, vL, vR);
         outL += vL;
         outR += vR;
     }
@@ -1668,7 +2483,7 @@ void VoicePool::processSample (const SampleData& sample, double sr,
     if (previewIdx >= maxActive && voices[previewIdx].active)
     {
         float vL = 0.0f, vR = 0.0f;
-        processVoiceSample (previewIdx, sample, sr, vL, vR);
+        processVoiceSample (previewIdx, sample, getVoiceSource (voices[previewIdx], sample).getFrameView(), sr, vL, vR);
         outL += vL;
         outR += vR;
     }
@@ -1681,76 +2496,288 @@ void VoicePool::renderMainBusBlock (const SampleData& sample,
     if (destL) std::fill_n (destL, numSamples, 0.0f);
     if (destR) std::fill_n (destR, numSamples, 0.0f);
 
-    auto renderVoiceBlock = [&] (int vi)
-    {
-        for (int s = 0; s < numSamples; ++s)
-        {
-            float vL = 0.0f, vR = 0.0f;
-            processVoiceSample (vi, sample, sampleRate, vL, vR);
-            if (destL) destL[s] += vL;
-            if (destR) destR[s] += vR;
-        }
-    };
-
-    for (int vi = 0; vi < maxActive; ++vi)
-    {
-        if (voices[vi].active)
-            renderVoiceBlock (vi);
-    }
-
-    // Preview voice (LazyChopEngine / shift preview) — always on main bus
-    constexpr int previewIdx = kPreviewVoiceIndex;
-    if (previewIdx >= maxActive && voices[previewIdx].active)
-        renderVoiceBlock (previewIdx);
+    renderVoicesChunked (sample, &destL, &destR, 1, numSamples);
 }
 
 void VoicePool::renderRoutedBlock (const SampleData& sample,
                                     float* busL[], float* busR[], int numBuses, int numSamples)
 {
-    const int scratchSize = (int) std::min (scratchL.size(), scratchR.size());
-    jassert (scratchSize > 0);
-    if (scratchSize <= 0 || numSamples <= 0)
+    if (numBuses <= 0 || numSamples <= 0)
         return;
 
-    auto renderVoiceToScratch = [&] (int vi, int chunkSamples)
+    renderVoicesChunked (sample, busL, busR, numBuses, numSamples);
+}
+
+int VoicePool::getVoiceBus (int i, int numBuses, float* const* busL) const
+{
+    // Preview voice (LazyChopEngine / shift preview) — always on bus 0
+    if (i == kPreviewVoiceIndex && i >= maxActive)
+        return 0;
+
+    const int bus = voices[(size_t) i].outputBus;
+    if (bus < 0 || bus >= numBuses || busL[bus] == nullptr)
+        return 0;
+    return bus;
+}
+
+// Plain repitch voices that stay steady (no boundary, crossfade, envelope stage change)
+// for the whole chunk go through the lane kernel; everything else renders per voice.
+static bool isLaneRepitchCandidate (const Voice& v, int bufferFrames, int chunkSamples)
+{
+    if (v.stretchActive || v.bungeeActive || v.filterEnabled || v.frozen != nullptr)
+        return false;
+
+    if (getActiveRepitchMode (v.repitchMode) == RepitchMode::Sinc)
+        return false;
+
+    return v.envelope.isStageStableFor (chunkSamples)
+        && getRepitchSteadyRunLength (v, bufferFrames, chunkSamples) >= chunkSamples;
+}
+
+static void addLane (RepitchLaneState& lanes, int voiceIdx, const Voice& v)
+{
+    const int l = lanes.count++;
+    const auto li = (size_t) l;
+    lanes.voiceIndex[li] = voiceIdx;
+    lanes.position[li]   = v.position;
+    lanes.step[li]       = v.speed * v.direction;
+    lanes.envLevel[li]   = v.envelope.getLevel();
+    lanes.envKeep[li]    = v.envelope.getStageKeep();
+    lanes.envCoeff[li]   = v.envelope.getStageCoeff();
+    lanes.envTarget[li]  = v.envelope.getStageTarget();
+    lanes.velocity[li]   = v.velocity;
+    lanes.volume[li]     = v.volume;
+}
+
+void VoicePool::renderVoicesChunked (const SampleData& sample,
+                                     float* const* busL, float* const* busR, int numBuses, int numSamples)
+{
+    const auto& buffer = sample.getBuffer();
+    const int bufferFrames = juce::jmin (sample.getNumFrames(), buffer.getNumSamples());
+    const bool canUseLanes = buffer.getNumChannels() >= 2 && bufferFrames > 0 && sample.hasDirectBuffer();
+
+    constexpr int previewIdx = kPreviewVoiceIndex;
+    const bool renderPreview = previewIdx >= maxActive;
+
+    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += kVoiceRunSize)
     {
-        for (int s = 0; s < chunkSamples; ++s)
-            processVoiceSample (vi, sample, sampleRate, scratchL[s], scratchR[s]);
-    };
+        const int chunkSamples = juce::jmin (kVoiceRunSize, numSamples - chunkStart);
+        linearLanes.count = 0;
+        cubicLanes.count = 0;
+
+        const auto renderOne = [&] (int vi)
+        {
+            const auto& v = voices[(size_t) vi];
+            if (! v.active)
+                return;
 
-    auto accumulateScratchToBus = [&] (float* dstL, float* dstR, int chunkStart, int chunkSamples)
+            if (canUseLanes && isLaneRepitchCandidate (v, bufferFrames, chunkSamples))
+            {
+                auto& lanes = getActiveRepitchMode (v.repitchMode) == RepitchMode::Cubic ? cubicLanes : linearLanes;
+                addLane (lanes, vi, v);
+                return;
+            }
+
+            const int bus = getVoiceBus (vi, numBuses, busL);
+            renderVoiceBlock (vi, sample,
+                              busL[bus] != nullptr ? busL[bus] + chunkStart : nullptr,
+                              busR[bus] != nullptr ? busR[bus] + chunkStart : nullptr,
+                              chunkSamples);
+        };
+
+        for (int vi = 0; vi < maxActive; ++vi)
+            renderOne (vi);
+
+        if (renderPreview)
+            renderOne (previewIdx);
+
+        if (linearLanes.count > 0)
+            renderRepitchLanes (linearLanes, false, sample, busL, busR, numBuses, chunkStart, chunkSamples);
+        if (cubicLanes.count > 0)
+            renderRepitchLanes (cubicLanes, true, sample, busL, busR, numBuses, chunkStart, chunkSamples);
+    }
+
+    releaseFinishedVoices();
+}
+
+void VoicePool::releaseFinishedVoices()
+{
+    // Finished voices hand their engines back for the next note-on, and let go
+    // of their freeze render so it can be freed once retired.
+    for (auto& v : voices)
     {
-        for (int s = 0; s < chunkSamples; ++s)
+        if (v.active)
+            continue;
+
+        StretchFreezeCache::releaseVoiceRef (v.frozen);
+
+        if (v.stretcher != nullptr)
         {
-            if (dstL) dstL[chunkStart + s] += scratchL[s];
-            if (dstR) dstR[chunkStart + s] += scratchR[s];
+            stretcherPool.releaseSignalsmith (v.stretcher);
+            v.stretcher = nullptr;
+            v.stretchActive = false;
         }
-    };
 
-    for (int chunkStart = 0; chunkStart < numSamples; chunkStart += scratchSize)
-    {
-        const int chunkSamples = std::min (scratchSize, numSamples - chunkStart);
+        if (v.bungeeStretcher != nullptr)
+        {
+            stretcherPool.releaseBungee (v.bungeeStretcher, v.bungeeHopAdjust);
+            v.bungeeStretcher = nullptr;
+            v.bungeeOutL = nullptr;
+            v.bungeeOutR = nullptr;
+            v.bungeeActive = false;
+        }
+    }
+}
 
-        for (int vi = 0; vi < maxActive; ++vi)
+// Advances kLanes packed repitch voices by numSamples. Per-lane frame gathers are scalar;
+// interpolation, envelope one-pole and gain run on SIMD registers. Output is
+// lane-interleaved: out[k * kLanes + lane].
+template <bool Cubic>
+static void runRepitchLaneKernel (RepitchLaneState& lanes, int first,
+                                  const float* dataL, const float* dataR,
+                                  float* outL, float* outR, int numSamples)
+{
+    using Vec = SimdOps::FloatVec;
+    constexpr int W = Vec::kLanes;
+
+    alignas (32) float frac[W];
+    alignas (32) float tapsL[4][W];
+    alignas (32) float tapsR[4][W];
+
+    auto* position = lanes.position.data() + first;
+    const auto* step = lanes.step.data() + first;
+
+    Vec env    = Vec::load (lanes.envLevel.data() + first);
+    const Vec keep     = Vec::load (lanes.envKeep.data() + first);
+    const Vec coeff    = Vec::load (lanes.envCoeff.data() + first);
+    const Vec target   = Vec::load (lanes.envTarget.data() + first);
+    const Vec velocity = Vec::load (lanes.velocity.data() + first);
+    const Vec volume   = Vec::load (lanes.volume.data() + first);
+
+    for (int k = 0; k < numSamples; ++k)
+    {
+        for (int l = 0; l < W; ++l)
         {
-            if (! voices[vi].active)
-                continue;
+            const double pos = position[l];
+            const double baseFloor = std::floor (pos);
+            const int base = (int) baseFloor;
+            frac[l] = (float) (pos - baseFloor);
 
-            renderVoiceToScratch (vi, chunkSamples);
+            if constexpr (Cubic)
+            {
+                for (int t = 0; t < 4; ++t)
+                {
+                    tapsL[t][l] = dataL[base - 1 + t];
+                    tapsR[t][l] = dataR[base - 1 + t];
+                }
+            }
+            else
+            {
+                tapsL[0][l] = dataL[base];
+                tapsL[1][l] = dataL[base + 1];
+                tapsR[0][l] = dataR[base];
+                tapsR[1][l] = dataR[base + 1];
+            }
 
-            int bus = voices[vi].outputBus;
-            if (bus < 0 || bus >= numBuses || busL[bus] == nullptr)
-                bus = 0;
+            position[l] = pos + step[l];
+        }
+
+        const Vec f = Vec::load (frac);
+        Vec yL, yR;
 
-            accumulateScratchToBus (busL[bus], busR[bus], chunkStart, chunkSamples);
+        if constexpr (Cubic)
+        {
+            // Catmull-Rom, same form as SampleData::interpolateCubic
+            const auto cubic = [&f] (const float (&taps)[4][W])
+            {
+                const Vec y0 = Vec::load (taps[0]);
+                const Vec y1 = Vec::load (taps[1]);
+                const Vec y2 = Vec::load (taps[2]);
+                const Vec y3 = Vec::load (taps[3]);
+                const Vec a0 = Vec::splat (-0.5f) * y0 + Vec::splat (1.5f) * y1
+                             - Vec::splat (1.5f) * y2 + Vec::splat (0.5f) * y3;
+                const Vec a1 = y0 - Vec::splat (2.5f) * y1 + Vec::splat (2.0f) * y2 - Vec::splat (0.5f) * y3;
+                const Vec a2 = Vec::splat (-0.5f) * y0 + Vec::splat (0.5f) * y2;
+                return ((a0 * f + a1) * f + a2) * f + y1;
+            };
+            yL = cubic (tapsL);
+            yR = cubic (tapsR);
+        }
+        else
+        {
+            const Vec l0 = Vec::load (tapsL[0]);
+            const Vec r0 = Vec::load (tapsR[0]);
+            yL = l0 + (Vec::load (tapsL[1]) - l0) * f;
+            yR = r0 + (Vec::load (tapsR[1]) - r0) * f;
         }
 
-        // Preview voice — always to bus 0
-        constexpr int previewIdx = kPreviewVoiceIndex;
-        if (previewIdx >= maxActive && voices[previewIdx].active)
+        // Same steps and operand order as AdsrEnvelope::processSample() and the
+        // per-voice gain, so lane voices track non-lane ones.
+        env = env * keep + coeff * (target - env);
+        const Vec g = env * velocity * volume;
+        (yL * g).store (outL + k * W);
+        (yR * g).store (outR + k * W);
+    }
+
+    env.store (lanes.envLevel.data() + first);
+}
+
+void VoicePool::renderRepitchLanes (RepitchLaneState& lanes, bool cubic, const SampleData& sample,
+                                    float* const* busL, float* const* busR, int numBuses,
+                                    int chunkStart, int chunkSamples)
+{
+    constexpr int W = SimdOps::FloatVec::kLanes;
+    static_assert (RepitchLaneState::kCapacity % W == 0);
+
+    const auto& buffer = sample.getBuffer();
+    const float* dataL = buffer.getReadPointer (0);
+    const float* dataR = buffer.getReadPointer (1);
+
+    // Pad the last group with silent copies of lane 0 so every read stays in range
+    const int paddedCount = (lanes.count + W - 1) / W * W;
+    for (int l = lanes.count; l < paddedCount; ++l)
+    {
+        const auto li = (size_t) l;
+        lanes.position[li]  = lanes.position[0];
+        lanes.step[li]      = 0.0;
+        lanes.envLevel[li]  = 0.0f;
+        lanes.envKeep[li]   = 1.0f;
+        lanes.envCoeff[li]  = 0.0f;
+        lanes.envTarget[li] = 0.0f;
+        lanes.velocity[li]  = 0.0f;
+        lanes.volume[li]    = 0.0f;
+    }
+
+    alignas (32) float outL[kVoiceRunSize * W];
+    alignas (32) float outR[kVoiceRunSize * W];
+
+    for (int first = 0; first < lanes.count; first += W)
+    {
+        if (cubic)
+            runRepitchLaneKernel<true> (lanes, first, dataL, dataR, outL, outR, chunkSamples);
+        else
+            runRepitchLaneKernel<false> (lanes, first, dataL, dataR, outL, outR, chunkSamples);
+
+        const int groupCount = juce::jmin (W, lanes.count - first);
+        for (int l = 0; l < groupCount; ++l)
         {
-            renderVoiceToScratch (previewIdx, chunkSamples);
-            accumulateScratchToBus (busL[0], busR[0], chunkStart, chunkSamples);
+            const auto li = (size_t) (first + l);
+            const int vi = lanes.voiceIndex[li];
+            auto& v = voices[(size_t) vi];
+
+            const int bus = getVoiceBus (vi, numBuses, busL);
+            float* dstL = busL[bus];
+            float* dstR = busR[bus];
+            for (int k = 0; k < chunkSamples; ++k)
+            {
+                if (dstL) dstL[chunkStart + k] += outL[k * W + l];
+                if (dstR) dstR[chunkStart + k] += outR[k * W + l];
+            }
+
+            // Sync the mirror back into the voice
+            v.position = lanes.position[li];
+            v.envelope.setStageLevel (lanes.envLevel[li]);
+            publishVoicePosition (vi);
         }
     }
 }
@@ -1,12 +1,17 @@
 #pragma once
 #include "Voice.h"
+#include "StretchWarmStartCache.h"
+#include "StretchFreezeCache.h"
 #include "SliceManager.h"
 #include "SampleData.h"
 #include "../Constants.h"
 #include <array>
 #include <atomic>
+#include <vector>
 #include <juce_core/juce_core.h>
 
+class SampleStreamer;
+
 // All global parameter values needed to start a voice, pre-loaded from APVTS on the UI thread.
 // Units match slice storage: seconds for ADSR, 0-1 for sustain, dB for volume.
 struct VoiceStartParams
@@ -49,6 +54,7 @@ struct VoiceStartParams
     float globalFilterEnvReleaseSec = 0.0f;
     float globalFilterEnvAmount     = 0.0f;
     float globalCrossfadePct        = 0.0f;
+    bool  freezeStretch             = false;
     int   rootNote = kDefaultRootNote;
     int   sliceRootNote = kDefaultRootNote;  // per-slice root for range transpose
 };
@@ -69,11 +75,49 @@ struct PreviewStretchParams
     const SampleData* sample = nullptr;
 };
 
+// Structure-of-arrays mirror of the hot state of plain repitch voices (no filter,
+// no stretch), packed per render chunk so the lane kernel can advance several
+// voices per SIMD register. Position and envelope level are written back after.
+struct RepitchLaneState
+{
+    static constexpr int kCapacity = 32;
+
+    alignas (32) std::array<double, kCapacity> position {};
+    alignas (32) std::array<double, kCapacity> step {};
+    alignas (32) std::array<float, kCapacity> envLevel {};
+    alignas (32) std::array<float, kCapacity> envKeep {};
+    alignas (32) std::array<float, kCapacity> envCoeff {};
+    alignas (32) std::array<float, kCapacity> envTarget {};
+    alignas (32) std::array<float, kCapacity> velocity {};
+    alignas (32) std::array<float, kCapacity> volume {};
+    std::array<int, kCapacity> voiceIndex {};
+    int count = 0;
+};
+
+// Input scratch for the stretch engines, shared by every voice one thread renders.
+// Each fill call consumes its input before returning, so only output that is read
+// out over later samples stays on the Voice.
+struct StretchScratch
+{
+    std::vector<float> stretchInL, stretchInR;
+    std::vector<float> bungeeIn;   // one plane per channel, bungeeInFrames apart
+    int bungeeInFrames = 0;
+
+    void allocate (int maxStretchInput, int maxBungeeInput)
+    {
+        stretchInL.assign ((size_t) maxStretchInput, 0.0f);
+        stretchInR.assign ((size_t) maxStretchInput, 0.0f);
+        bungeeIn.assign ((size_t) maxBungeeInput * 2, 0.0f);
+        bungeeInFrames = maxBungeeInput;
+    }
+};
+
 class VoicePool
 {
 public:
     static constexpr int kMaxVoices = 32;
     static constexpr int kPreviewVoiceIndex = kMaxVoices - 1;
+    static_assert (RepitchLaneState::kCapacity == kMaxVoices);
 
     VoicePool();
 
@@ -128,25 +172,72 @@ public:
                                         int endSample,
                                         bool looping,
                                         float velocity);
-    static void initPreviewVoiceStretch (Voice& v, int sourceStartSample, const PreviewStretchParams& params);
-    static void initStretcher (Voice& v, float pitchSemis, double sr,
-                               float tonalityHz, float formantSemis, bool formantComp,
-                               const SampleData& sample);
-    static void initBungee (Voice& v, float pitchSemis, double sr, int grainMode);
+    void initPreviewVoiceStretch (Voice& v, int sourceStartSample, const PreviewStretchParams& params);
+    void initStretcher (Voice& v, float pitchSemis, double sr,
+                        float tonalityHz, float formantSemis, bool formantComp,
+                        const SampleData& sample);
+    void initBungee (Voice& v, float pitchSemis, double sr, int grainMode);
+
+    // Keeps the per-slice Signalsmith warm starts and freeze renders in step with
+    // slice edits, lock toggles, global params and host tempo. Audio thread; cheap
+    // when nothing changed.
+    bool isStretchCacheRefreshDue (int numSamples);
+    void refreshStretchCaches (const VoiceStartParams& base, const SliceManager& sm, const SampleData& sample);
+
+    // Tells the streamer where each voice reads so it can stream ahead of it.
+    // Audio thread, once per block while the session is streamed.
+    void publishStreamHints (SampleStreamer& streamer) const;
+
+    // Worker thread: renders a slice exactly as a one-shot stretch voice would play it.
+    static bool renderFrozenStretch (const StretchFreezeKey& key, const SampleData& source,
+                                     std::vector<float>& outL, std::vector<float>& outR);
 
     // Atomic voice positions for UI cursor display
     std::array<std::atomic<float>, kMaxVoices> voicePositions;
     std::array<std::atomic<float>, kMaxVoices> xfadeSourcePositions;
 
-    void processVoiceSample (int i, const SampleData& sample, double sampleRate,
-                             float& outL, float& outR);
+    // Sample-by-sample reference path; renderVoiceBlock falls back to it at boundaries.
+    // frames is the frame view of the voice's source, resolved by the caller.
+    void processVoiceSample (int i, const SampleData& sample, const SampleData::FrameView& frames,
+                             double sampleRate, float& outL, float& outR);
+
+    // Renders voice i and accumulates into destL/destR (either may be null).
+    // Steady stretches between boundaries run through tight per-run loops.
+    void renderVoiceBlock (int i, const SampleData& sample,
+                           float* destL, float* destR, int numSamples);
 
 private:
+    void publishVoicePosition (int i);
+    void releaseFinishedVoices();
+    void renderVoicesChunked (const SampleData& sample,
+                              float* const* busL, float* const* busR, int numBuses, int numSamples);
+    void renderRepitchLanes (RepitchLaneState& lanes, bool cubic, const SampleData& sample,
+                             float* const* busL, float* const* busR, int numBuses,
+                             int chunkStart, int chunkSamples);
+    int getVoiceBus (int i, int numBuses, float* const* busL) const;
+    void startSliceStretcher (Voice& v, int sliceIdx, const StretchWarmStartKey& key,
+                              float tonalityHz, float formantSemis, bool formantComp,
+                              const SampleData& sample);
+
+    bool startFrozenVoice (Voice& v, int sliceIdx, const StretchFreezeKey& key);
+    static int numStretchVoices (int playableVoices);
+
+    static constexpr double kStretchCacheRefreshSec = 0.1;
+
+    RepitchLaneState linearLanes;
+    RepitchLaneState cubicLanes;
+
     std::array<Voice, kMaxVoices> voices;
+    StretchScratch scratch;   // audio thread
+    StretcherPool stretcherPool;
+    StretchWarmStartCache warmStarts;   // after stretcherPool: its worker must stop first
+    std::array<StretchWarmStartKey, SliceManager::kMaxSlices> requestedWarmStarts {};
+    StretchFreezeCache freezeCache;
+    std::array<StretchFreezeKey, SliceManager::kMaxSlices> requestedFreezes {};
+    std::array<StretchFreezeKey, SliceManager::kMaxSlices> seenFreezes {};   // last refresh pass's keys
+    bool freezeWasEnabled = false;
+    int stretchCacheRefreshCountdown = 0;
     int maxActive = 16; // playable voices, excluding preview voice
+    int requestedMaxActive = 16;   // last setMaxActiveVoices(); maxActive catches up as the pool grows
     double sampleRate = 44100.0;
-
-    // Preallocated scratch buffers for block rendering (sized to maxBlockSize)
-    std::vector<float> scratchL;
-    std::vector<float> scratchR;
 };
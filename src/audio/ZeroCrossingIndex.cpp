@@ -0,0 +1,96 @@
+#include "ZeroCrossingIndex.h"
+#include "SimdOps.h"
+#include <algorithm>
+#include <bit>
+
+std::shared_ptr<const ZeroCrossingIndex> ZeroCrossingIndex::build (int numFrames, const FrameReader& read)
+{
+    constexpr int kBlock = 8192;   // frames read per pass, a multiple of 64
+
+    std::shared_ptr<ZeroCrossingIndex> index (new ZeroCrossingIndex());
+    index->numFrames = std::max (0, numFrames);
+    const int numPages = (index->numFrames + (1 << kPageShift) - 1) >> kPageShift;
+
+    std::vector<float> left ((size_t) kBlock), right ((size_t) kBlock);
+    bool previousNegative = false;
+
+    for (int start = 0; start < index->numFrames; start += kBlock)
+    {
+        const int count = std::min (kBlock, index->numFrames - start);
+        read (0, start, count, left.data());
+        read (1, start, count, right.data());
+        std::fill (left.begin() + count, left.end(), 0.0f);
+        std::fill (right.begin() + count, right.end(), 0.0f);
+
+        for (int w = 0; w < count; w += 64)
+        {
+            const int valid = std::min (64, count - w);
+            const uint64_t validMask = valid == 64 ? ~(uint64_t) 0 : ((uint64_t) 1 << valid) - 1;
+            const uint64_t negative = SimdOps::negativeMonoMask64 (left.data() + w, right.data() + w) & validMask;
+
+            // Bit j: frame j's sign differs from frame j - 1's. Frame 0 has no predecessor.
+            uint64_t changes = (negative ^ ((negative << 1) | (previousNegative ? 1u : 0u))) & validMask;
+            if (start + w == 0)
+                changes &= ~(uint64_t) 1;
+            previousNegative = ((negative >> (valid - 1)) & 1u) != 0;
+
+            for (; changes != 0; changes &= changes - 1)
+            {
+                const int pos = start + w + std::countr_zero (changes);
+                while ((int) index->pageFirst.size() <= (pos >> kPageShift))
+                    index->pageFirst.push_back ((int) index->offsets.size());
+                index->offsets.push_back ((uint16_t) (pos & ((1 << kPageShift) - 1)));
+            }
+        }
+    }
+
+    while ((int) index->pageFirst.size() <= numPages)
+        index->pageFirst.push_back ((int) index->offsets.size());
+
+    index->offsets.shrink_to_fit();
+    return index;
+}
+
+int ZeroCrossingIndex::positionAt (int k) const
+{
+    // The last page starting at or before k; empty pages share its start.
+    const auto page = std::upper_bound (pageFirst.begin(), pageFirst.end(), k) - pageFirst.begin() - 1;
+    return ((int) page << kPageShift) | offsets[(size_t) k];
+}
+
+int ZeroCrossingIndex::lowerBound (int pos) const
+{
+    const int page = pos >> kPageShift;
+    const auto first = offsets.begin() + pageFirst[(size_t) page];
+    const auto last = offsets.begin() + pageFirst[(size_t) page + 1];
+    return (int) (std::lower_bound (first, last, (uint16_t) (pos & ((1 << kPageShift) - 1))) - offsets.begin());
+}
+
+int ZeroCrossingIndex::findNearest (int pos, int searchRange) const
+{
+    if (numFrames == 0 || pos < 0 || pos >= numFrames)
+        return pos;
+
+    const int k = lowerBound (pos);
+    int bestPos = pos;
+    int bestDist = searchRange + 1;
+
+    if (k > 0)
+    {
+        const int before = positionAt (k - 1);
+        if (pos - before < bestDist)
+        {
+            bestDist = pos - before;
+            bestPos = before;
+        }
+    }
+
+    if (k < (int) offsets.size())
+    {
+        const int after = positionAt (k);
+        if (after - pos < bestDist)
+            bestPos = after;
+    }
+
+    return bestPos;
+}
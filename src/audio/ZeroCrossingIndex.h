@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Every sign change of a session's mono mix, for nearest-crossing lookups by
+// binary search at any search range. Crossings are kept as 16-bit offsets into
+// 64K-frame pages plus the index of each page's first crossing, so the index
+// costs about two bytes per crossing. Immutable once built; safe to query from
+// any thread, including the audio thread.
+class ZeroCrossingIndex
+{
+public:
+    static constexpr int kPageShift = 16;
+
+    // Reads channel frames [start, start + count) as float into dest.
+    using FrameReader = std::function<void (int channel, int start, int count, float* dest)>;
+
+    static std::shared_ptr<const ZeroCrossingIndex> build (int numFrames, const FrameReader& read);
+
+    int getNumFrames() const { return numFrames; }
+    int getNumCrossings() const { return (int) offsets.size(); }
+
+    // Nearest crossing within searchRange frames of pos (the earlier one on a
+    // tie), or pos if there is none; a crossing at i means frames i - 1 and i
+    // differ in sign. Matches AudioAnalysis::findNearestZeroCrossingIn.
+    int findNearest (int pos, int searchRange) const;
+
+private:
+    ZeroCrossingIndex() = default;
+
+    int positionAt (int k) const;
+    int lowerBound (int pos) const;
+
+    int numFrames = 0;
+    std::vector<uint16_t> offsets;   // within each page, ascending
+    std::vector<int> pageFirst;      // per page, index of its first crossing; one extra at the end
+};
@@ -33,6 +33,7 @@ struct GlobalParamSnapshot
     float volumeDb = 0.0f;
     float crossfadePct = 0.0f;
     int maxVoices = 16;
+    bool freezeStretch = false;
 
     bool filterEnabled = false;
     int filterType = 0;
@@ -97,6 +98,7 @@ struct GlobalParamSnapshot
         snapshot.volumeDb = loadFloat (ParamIds::masterVolume, snapshot.volumeDb);
         snapshot.crossfadePct = loadFloat (ParamIds::defaultCrossfade, snapshot.crossfadePct);
         snapshot.maxVoices = loadInt (ParamIds::maxVoices, snapshot.maxVoices);
+        snapshot.freezeStretch = loadBool (ParamIds::freezeStretch, snapshot.freezeStretch);
 
         snapshot.filterEnabled = loadBool (ParamIds::defaultFilterEnabled, snapshot.filterEnabled);
         snapshot.filterType = loadInt (ParamIds::defaultFilterType, snapshot.filterType);
@@ -38,5 +38,6 @@ namespace ParamIds
     inline const juce::String defaultFilterEnvAmount   { "defaultFilterEnvAmount" };
     inline const juce::String defaultCrossfade     { "defaultCrossfade" };
     inline const juce::String maxVoices           { "maxVoices" };
+    inline const juce::String freezeStretch       { "freezeStretch" };
     inline const juce::String uiScale             { "uiScale" };
 }
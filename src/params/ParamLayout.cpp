@@ -36,12 +36,34 @@ juce::AudioProcessorValueTreeState::ParameterLayout ParamLayout::createLayout()
         juce::StringArray { "Repitch", "Signalsmith", "Bungee" },
         0));
 
-    // Sample Repitch Mode: 0=Linear, 1=Cubic
-    params.push_back (std::make_unique<juce::AudioParameterChoice> (
-        juce::ParameterID { ParamIds::defaultRepitchMode, 1 },
-        "Sample Repitch Mode",
-        juce::StringArray { "Linear", "Cubic" },
-        0));
+    // Sample Repitch Mode: 0=Linear, 1=Cubic, 2=Sinc
+    // Shipped as a Linear/Cubic choice (normalised 0 and 1). Sinc takes the
+    // middle of the range so saved host automation keeps its meaning; the
+    // stored value is still the mode index.
+    {
+        const juce::StringArray modeNames { "Linear", "Cubic", "Sinc" };
+        juce::NormalisableRange<float> modeRange (
+            0.0f, 2.0f,
+            [] (float, float, float norm) { return norm < 0.25f ? 0.0f : (norm < 0.75f ? 2.0f : 1.0f); },
+            [] (float, float, float mode) { return mode < 0.5f ? 0.0f : (mode < 1.5f ? 1.0f : 0.5f); },
+            [] (float, float, float mode) { return juce::jlimit (0.0f, 2.0f, std::round (mode)); });
+        modeRange.interval = 1.0f;
+
+        params.push_back (std::make_unique<juce::AudioParameterFloat> (
+            juce::ParameterID { ParamIds::defaultRepitchMode, 1 },
+            "Sample Repitch Mode",
+            modeRange,
+            0.0f,
+            juce::AudioParameterFloatAttributes()
+                .withStringFromValueFunction ([modeNames] (float mode, int)
+                {
+                    return modeNames[juce::jlimit (0, 2, (int) std::round (mode))];
+                })
+                .withValueFromStringFunction ([modeNames] (const juce::String& text)
+                {
+                    return (float) juce::jmax (0, modeNames.indexOf (text.trim(), true));
+                })));
+    }
 
     // Sample Attack: 0..1000 ms, default 5ms
     params.push_back (std::make_unique<juce::AudioParameterFloat> (
@@ -246,6 +268,12 @@ juce::AudioProcessorValueTreeState::ParameterLayout ParamLayout::createLayout()
         "Max Voices",
         1, 31, 16));
 
+    // Freeze Stretch: render static one-shot stretch slices in the background
+    params.push_back (std::make_unique<juce::AudioParameterBool> (
+        juce::ParameterID { ParamIds::freezeStretch, 1 },
+        "Freeze Stretch",
+        false));
+
     // UI Scale: 0.5..3.0, default 1.0, step 0.25
     params.push_back (std::make_unique<juce::AudioParameterFloat> (
         juce::ParameterID { ParamIds::uiScale, 1 },
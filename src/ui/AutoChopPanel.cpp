@@ -13,9 +13,10 @@ AutoChopPanel::AutoChopPanel (IntersectProcessor& p, WaveformView& wv)
 {
     addAndMakeVisible (splitEqualBtn);
     addAndMakeVisible (detectBtn);
+    addAndMakeVisible (chopSessionBtn);
     addAndMakeVisible (cancelBtn);
 
-    for (auto* btn : { &splitEqualBtn, &detectBtn, &cancelBtn })
+    for (auto* btn : { &splitEqualBtn, &detectBtn, &chopSessionBtn, &cancelBtn })
     {
         btn->setColour (juce::TextButton::buttonColourId, getTheme().surface4);
         btn->setColour (juce::TextButton::textColourOnId, getTheme().text2);
@@ -24,6 +25,7 @@ AutoChopPanel::AutoChopPanel (IntersectProcessor& p, WaveformView& wv)
 
     splitEqualBtn.setTooltip ("Split equal");
     detectBtn.setTooltip ("Split transients");
+    chopSessionBtn.setTooltip ("Replace all slices with transient slices of every session sample");
     cancelBtn.setTooltip ("Close auto chop");
 
     splitEqualBtn.onClick = [this] {
@@ -60,6 +62,14 @@ AutoChopPanel::AutoChopPanel (IntersectProcessor& p, WaveformView& wv)
             parent->removeChildComponent (this);
     };
 
+    chopSessionBtn.onClick = [this] {
+        processor.startSessionAutoChop (sensCell.value * 0.1f, minCell.value);
+        waveformView.transientPreviewPositions.clear();
+        waveformView.repaint();
+        if (auto* parent = getParentComponent())
+            parent->removeChildComponent (this);
+    };
+
     cancelBtn.onClick = [this] {
         waveformView.transientPreviewPositions.clear();
         waveformView.repaint();
@@ -67,7 +77,7 @@ AutoChopPanel::AutoChopPanel (IntersectProcessor& p, WaveformView& wv)
             parent->removeChildComponent (this);
     };
 
-    // Hide action controls until ODF is ready (keep cancel visible)
+    // Hide slice actions until ODF is ready; session chop and cancel need no ODF
     splitEqualBtn.setVisible (false);
     detectBtn.setVisible (false);
 
@@ -159,7 +169,12 @@ void AutoChopPanel::resized()
     // SPLIT TRANSIENTS button
     int transBtnW = 148;
     detectBtn.setBounds (x, pad, transBtnW, btnH);
-    x += transBtnW + gap + 16;
+    x += transBtnW + gap;
+
+    // CHOP SESSION button
+    int sessionBtnW = 112;
+    chopSessionBtn.setBounds (x, pad, sessionBtnW, btnH);
+    x += sessionBtnW + gap + 16;
 
     // DIV cell
     divCell.bounds = { x, pad, 48, btnH };
@@ -352,8 +367,8 @@ void AutoChopPanel::startODFComputation()
 
     const double sampleRate = sampleSnap->decodedSampleRate > 0.0 ? sampleSnap->decodedSampleRate : 44100.0;
 
-    // Hold onto the snapshot so the buffer stays alive for the thread
-    odfBufferSnapshot = std::make_shared<juce::AudioBuffer<float>> (sampleSnap->buffer);
+    // Only the slice is copied; the ODF and picking work in slice-relative frames.
+    odfBufferSnapshot = std::make_shared<juce::AudioBuffer<float>> (sampleSnap->copyFrames (sliceStart, sliceEnd - sliceStart));
     cachedSliceStart = sliceStart;
     cachedSliceEnd   = sliceEnd;
 
@@ -362,9 +377,22 @@ void AutoChopPanel::startODFComputation()
     {
         odfThread->signalThreadShouldExit();
         odfThread->stopThread (500);
+        odfThread.reset();
     }
 
-    odfThread = std::make_unique<ODFThread> (*odfBufferSnapshot, sliceStart, sliceEnd, sampleRate);
+    // The session's ODF is usually analysed already; slice it instead.
+    if (processor.getOdfCache().find (*sampleSnap, sliceStart, sliceEnd, cachedODF))
+    {
+        cachedODF.start -= sliceStart;
+        cachedODF.end -= sliceStart;
+        cachedODF.frameStart -= sliceStart;
+        stopTimer();
+        onODFReady();
+        return;
+    }
+
+    odfThread = std::make_unique<ODFThread> (*odfBufferSnapshot, 0, sliceEnd - sliceStart, sampleRate,
+                                             processor.getWorkerPool());
     odfThread->startThread (juce::Thread::Priority::background);
 
     // Poll for completion
@@ -388,20 +416,25 @@ void AutoChopPanel::timerCallback()
         stopTimer();
         cachedODF = std::move (odfThread->result);
         odfThread.reset();
-        odfReady = true;
+        onODFReady();
+    }
+}
+
+void AutoChopPanel::onODFReady()
+{
+    odfReady = true;
 
-        splitEqualBtn.setVisible (true);
-        detectBtn.setVisible (true);
-        cancelBtn.setVisible (true);
+    splitEqualBtn.setVisible (true);
+    detectBtn.setVisible (true);
+    cancelBtn.setVisible (true);
 
-        updatePreviewFromCachedODF();
-        repaint(); // redraw to show controls instead of "Analyzing..."
-    }
+    updatePreviewFromCachedODF();
+    repaint(); // redraw to show controls instead of "Analyzing..."
 }
 
 void AutoChopPanel::updatePreviewFromCachedODF()
 {
-    if (! odfReady)
+    if (! odfReady || odfBufferSnapshot == nullptr)
         return;
 
     auto sampleSnap = processor.sampleData.getSnapshot();
@@ -417,7 +450,9 @@ void AutoChopPanel::updatePreviewFromCachedODF()
     const double sampleRate = sampleSnap->decodedSampleRate > 0.0 ? sampleSnap->decodedSampleRate : 44100.0;
 
     auto positions = AudioAnalysis::pickTransientsFromODF (
-        cachedODF, sampleSnap->buffer, sens, sampleRate, minMs);
+        cachedODF, *odfBufferSnapshot, sens, sampleRate, minMs);
+    for (auto& p : positions)
+        p += cachedSliceStart;
 
     if (processor.snapToZeroCrossing.load())
     {
@@ -425,8 +460,7 @@ void AutoChopPanel::updatePreviewFromCachedODF()
         int sliceEnd = cachedSliceEnd;
         std::transform (positions.begin(), positions.end(), positions.begin(),
                         [sampleSnap, sliceStart, sliceEnd] (int p) {
-                            int snapped = AudioAnalysis::findNearestZeroCrossing (
-                                sampleSnap->buffer, p);
+                            int snapped = SampleData::findNearestZeroCrossing (*sampleSnap, p);
                             return juce::jlimit (sliceStart + 1, sliceEnd - 1, snapped);
                         });
 
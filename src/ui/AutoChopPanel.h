@@ -35,6 +35,7 @@ private:
     void updatePreview();
     void updatePreviewFromCachedODF();
     void startODFComputation();
+    void onODFReady();
     int hitTestCell (juce::Point<int> pos) const;
     void showTextEditor (ParamCell& cell);
     void dismissTextEditor();
@@ -50,6 +51,7 @@ private:
 
     juce::TextButton splitEqualBtn { "SPLIT EQUAL" };
     juce::TextButton detectBtn     { "SPLIT TRANSIENTS" };
+    juce::TextButton chopSessionBtn { "CHOP SESSION" };
     juce::TextButton cancelBtn     { "CANCEL" };
 
     int activeDragCell = -1;
@@ -68,12 +70,12 @@ private:
     class ODFThread : public juce::Thread
     {
     public:
-        ODFThread (const juce::AudioBuffer<float>& buf, int start, int end, double sr)
-            : juce::Thread ("ODF-Compute"), buffer (buf), sliceStart (start), sliceEnd (end), sampleRate (sr) {}
+        ODFThread (const juce::AudioBuffer<float>& buf, int start, int end, double sr, juce::ThreadPool& helpers)
+            : juce::Thread ("ODF-Compute"), buffer (buf), sliceStart (start), sliceEnd (end), sampleRate (sr), pool (helpers) {}
 
         void run() override
         {
-            result = AudioAnalysis::computeSpectralFluxODF (buffer, sliceStart, sliceEnd, sampleRate);
+            result = AudioAnalysis::computeSpectralFluxODF (buffer, sliceStart, sliceEnd, sampleRate, &pool);
         }
 
         AudioAnalysis::ODFResult result;
@@ -82,6 +84,7 @@ private:
         const juce::AudioBuffer<float>& buffer;
         int sliceStart, sliceEnd;
         double sampleRate;
+        juce::ThreadPool& pool;
     };
 
     std::unique_ptr<ODFThread> odfThread;
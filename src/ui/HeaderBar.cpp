@@ -26,8 +26,37 @@ enum SettingsMenuItemId
     kMenuStemDownloadMissing,
     kMenuStemCancelDownloads,
     kMenuStemDownloadBase = 4100,
+    kMenuRetainSourcePcm = 5000,
+    kMenuStreamFromDisk,
+    kMenuDiskDecodeCache,
+    kMenuRegionCacheBase = 5100,  // +i = kRegionCacheSizesMb[i]
+    kMenuStorageBase = 5200,      // +SampleData::Storage
 };
 
+// Choices for the decoded audio cache, which all instances share.
+constexpr int kRegionCacheSizesMb[] = { 0, 128, 256, 512, 1024 };
+
+juce::String formatStorage (SampleData::Storage storage)
+{
+    switch (storage)
+    {
+        case SampleData::Storage::Int16: return "16-bit";
+        case SampleData::Storage::Half:  return "Half Float";
+        case SampleData::Storage::Interleaved: return "32-bit Float + Interleaved";
+        case SampleData::Storage::Float32: break;
+    }
+    return "32-bit Float";
+}
+
+juce::String formatCacheSize (int megabytes)
+{
+    if (megabytes == 0)
+        return "Off";
+    if (megabytes >= 1024)
+        return juce::String (megabytes / 1024) + " GB";
+    return juce::String (megabytes) + " MB";
+}
+
 float measureTextWidth (const juce::Font& font, const juce::String& text)
 {
     juce::GlyphArrangement glyphs;
@@ -311,6 +340,34 @@ void HeaderBar::showSettingsPopup()
     stemMenu.addItem (0x4fff, "Installed Models  " + juce::String ((int) installedModels.size()), false, false);
     menu.addSubMenu ("Stem Separation", stemMenu);
 
+    const int regionCacheMb = (int) (processor.getDecodedRegionCacheCapacity() / (1024 * 1024));
+    juce::PopupMenu regionCacheMenu;
+    regionCacheMenu.setLookAndFeel (&getLookAndFeel());
+    regionCacheMenu.addSectionHeader ("Decoded Audio Cache");
+    for (int i = 0; i < (int) std::size (kRegionCacheSizesMb); ++i)
+        regionCacheMenu.addItem (kMenuRegionCacheBase + i, formatCacheSize (kRegionCacheSizesMb[i]),
+                                 true, regionCacheMb == kRegionCacheSizesMb[i]);
+
+    juce::PopupMenu memoryMenu;
+    memoryMenu.setLookAndFeel (&getLookAndFeel());
+    memoryMenu.addSectionHeader ("Memory");
+    memoryMenu.addSubMenu ("Decoded Audio Cache  " + formatCacheSize (regionCacheMb), regionCacheMenu);
+    memoryMenu.addItem (kMenuRetainSourcePcm, "Keep Source-Rate Audio", true, processor.isRetainingSourcePcm());
+    memoryMenu.addSeparator();
+    memoryMenu.addSectionHeader ("This Project");
+    memoryMenu.addItem (kMenuStreamFromDisk, "Stream Samples From Disk", true, processor.isStreamingMode());
+    memoryMenu.addItem (kMenuDiskDecodeCache, "Cache Decoded Audio On Disk", true, processor.isDiskDecodeCacheEnabled());
+
+    const auto storage = processor.getSampleStorage();
+    juce::PopupMenu storageMenu;
+    storageMenu.setLookAndFeel (&getLookAndFeel());
+    storageMenu.addSectionHeader ("Sample Storage");
+    for (auto option : { SampleData::Storage::Float32, SampleData::Storage::Interleaved,
+                         SampleData::Storage::Int16, SampleData::Storage::Half })
+        storageMenu.addItem (kMenuStorageBase + (int) option, formatStorage (option), true, storage == option);
+    memoryMenu.addSubMenu ("Sample Storage  " + formatStorage (storage), storageMenu);
+    menu.addSubMenu ("Memory", memoryMenu);
+
     menu.addSeparator();
     menu.addSectionHeader ("Support");
     menu.addItem (kMenuSponsor, juce::CharPointer_UTF8 ("\xe2\x98\x95  Buy Me a Coffee"));
@@ -427,6 +484,32 @@ void HeaderBar::showSettingsPopup()
                 const auto& entry = getStemModelCatalog()[(size_t) (result - kMenuStemDownloadBase)];
                 processor.startStemModelDownload ({ entry.id });
             }
+            else if (result == kMenuRetainSourcePcm)
+            {
+                processor.setRetainSourcePcm (! processor.isRetainingSourcePcm());
+                editor->saveUserSettings (scale, getTheme().name);
+            }
+            else if (result == kMenuStreamFromDisk)
+            {
+                processor.setStreamingMode (! processor.isStreamingMode());
+                processor.showTransientStatusMessage ("Streaming applies from the next load", false);
+            }
+            else if (result == kMenuDiskDecodeCache)
+            {
+                processor.setDiskDecodeCacheEnabled (! processor.isDiskDecodeCacheEnabled());
+            }
+            else if (result >= kMenuStorageBase && result <= kMenuStorageBase + (int) SampleData::Storage::Interleaved)
+            {
+                processor.setSampleStorage ((SampleData::Storage) (result - kMenuStorageBase));
+                processor.showTransientStatusMessage ("Sample storage applies from the next load", false);
+            }
+            else if (result >= kMenuRegionCacheBase
+                     && result < kMenuRegionCacheBase + (int) std::size (kRegionCacheSizesMb))
+            {
+                const int megabytes = kRegionCacheSizesMb[result - kMenuRegionCacheBase];
+                processor.setDecodedRegionCacheCapacity ((size_t) megabytes * 1024 * 1024);
+                editor->saveUserSettings (scale, getTheme().name);
+            }
         });
 }
 
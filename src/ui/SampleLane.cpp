@@ -40,7 +40,7 @@ std::vector<SampleLane::VisibleSample> SampleLane::buildVisibleSamples() const
     if (sampleSnap == nullptr)
         return out;
 
-    const int numFrames = sampleSnap->buffer.getNumSamples();
+    const int numFrames = sampleSnap->getNumFrames();
     if (numFrames <= 0 || getWidth() <= 0)
         return out;
 
@@ -234,6 +234,17 @@ void SampleLane::paint (juce::Graphics& g)
         }
     }
 
+    // Draw multi-file load progress across the lane
+    if (ui.sampleLoadFilesTotal > 1)
+    {
+        const int barH = 3;
+        const float progress = (float) ui.sampleLoadFilesDone / (float) ui.sampleLoadFilesTotal;
+        g.setColour (getTheme().accent.withAlpha (0.4f));
+        g.fillRect (0, h - barH, getWidth(), barH);
+        g.setColour (getTheme().accent.withAlpha (0.9f));
+        g.fillRect (0, h - barH, juce::jmax (1, juce::roundToInt (progress * (float) getWidth())), barH);
+    }
+
     if (dragging && dragTargetIndex >= 0)
     {
         int insertX = getWidth() - 1;
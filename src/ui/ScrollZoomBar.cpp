@@ -21,7 +21,7 @@ void ScrollZoomBar::paint (juce::Graphics& g)
     g.drawHorizontalLine (0, 0.0f, (float) w);
 
     auto sampleSnap = processor.sampleData.getSnapshot();
-    int numFrames = sampleSnap ? sampleSnap->buffer.getNumSamples() : 0;
+    int numFrames = sampleSnap ? sampleSnap->getNumFrames() : 0;
     if (numFrames <= 0 || w <= 0)
         return;
 
@@ -1142,9 +1142,9 @@ void SignalChainBar::rebuildTimePitchModule (const LayoutInput& input,
         cell.lockBit = kLockRepitchMode;
         cell.currentValue = (float) resolvedRepitchMode;
         cell.minVal = 0.0f;
-        cell.maxVal = 1.0f;
+        cell.maxVal = 2.0f;
         cell.step = 1.0f;
-        cell.choiceCount = 2;
+        cell.choiceCount = 3;
         cell.isChoice = true;
         cell.isLocked = repitchModeLocked;
         cell.bounds = row2[1];
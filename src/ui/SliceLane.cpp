@@ -23,7 +23,7 @@ void SliceLane::paint (juce::Graphics& g)
     g.fillAll (getTheme().surface0);
 
     auto sampleSnap = processor.sampleData.getSnapshot();
-    int numFrames = sampleSnap ? sampleSnap->buffer.getNumSamples() : 0;
+    int numFrames = sampleSnap ? sampleSnap->getNumFrames() : 0;
     if (numFrames <= 0)
         return;
 
@@ -140,7 +140,7 @@ void SliceLane::mouseDown (const juce::MouseEvent& e)
         onInteraction();
 
     auto sampleSnap = processor.sampleData.getSnapshot();
-    int numFrames = sampleSnap ? sampleSnap->buffer.getNumSamples() : 0;
+    int numFrames = sampleSnap ? sampleSnap->getNumFrames() : 0;
     if (numFrames <= 0)
         return;
 
@@ -2,8 +2,7 @@
 #include <algorithm>
 #include <cmath>
 
-void WaveformCache::rebuild (const juce::AudioBuffer<float>& buffer,
-                             const std::array<SampleData::PeakMipmap, SampleData::kNumMipmapLevels>& mipmaps,
+void WaveformCache::rebuild (const SampleData::DecodedSample& sample,
                              int numFrames, float zoom, float scroll, int widthPixels)
 {
     if (numFrames <= 0 || widthPixels <= 0)
@@ -19,20 +18,18 @@ void WaveformCache::rebuild (const juce::AudioBuffer<float>& buffer,
     peaks.resize ((size_t) widthPixels);
     float samplesPerPixel = (float) visibleLen / (float) widthPixels;
 
-    if (buffer.getNumChannels() < 1)
+    if (sample.compact == nullptr && sample.buffer.getNumChannels() < 1)
     {
         peaks.clear();
         return;
     }
 
-    const float* dataL = buffer.getReadPointer (0);
-    const float* dataR = buffer.getNumChannels() > 1 ? buffer.getReadPointer (1) : dataL;
-
-    if (dataL == nullptr)
+    // Compact samples have no float buffer, so raw reads go through the sample.
+    const auto readMid = [&sample] (int frame)
     {
-        peaks.clear();
-        return;
-    }
+        return (sample.getSample (frame, 0) + sample.getSample (frame, 1)) * 0.5f;
+    };
+    const auto& mipmaps = sample.peakMipmaps;
 
     if (samplesPerPixel < 1.0f)
     {
@@ -43,9 +40,8 @@ void WaveformCache::rebuild (const juce::AudioBuffer<float>& buffer,
             int ipos = (int) exactPos;
             float frac = exactPos - ipos;
             ipos = std::max (0, std::min (ipos, numFrames - 2));
-            float valL = dataL[ipos] + (dataL[ipos + 1] - dataL[ipos]) * frac;
-            float valR = dataR[ipos] + (dataR[ipos + 1] - dataR[ipos]) * frac;
-            float val = (valL + valR) * 0.5f;
+            const float a = readMid (ipos);
+            float val = a + (readMid (ipos + 1) - a) * frac;
             peaks[(size_t) px] = { val, val };
         }
         return;
@@ -106,7 +102,7 @@ void WaveformCache::rebuild (const juce::AudioBuffer<float>& buffer,
             float lo = 1.0f;
             for (int s = sStart; s < sEnd; ++s)
             {
-                float val = (dataL[s] + dataR[s]) * 0.5f;
+                float val = readMid (s);
                 if (val > hi) hi = val;
                 if (val < lo) lo = val;
             }
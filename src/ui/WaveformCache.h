@@ -8,8 +8,7 @@ class WaveformCache
 public:
     struct Peak { float maxVal = 0.0f; float minVal = 0.0f; };
 
-    void rebuild (const juce::AudioBuffer<float>& buffer,
-                  const std::array<SampleData::PeakMipmap, SampleData::kNumMipmapLevels>& mipmaps,
+    void rebuild (const SampleData::DecodedSample& sample,
                   int numFrames, float zoom, float scroll, int widthPixels);
 
     const std::vector<Peak>& getPeaks() const { return peaks; }
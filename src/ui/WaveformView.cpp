@@ -4,7 +4,6 @@
 #include "LinuxDesktopSupport.h"
 #include "../Constants.h"
 #include "../PluginProcessor.h"
-#include "../audio/AudioAnalysis.h"
 
 namespace
 {
@@ -191,7 +190,7 @@ WaveformView::ViewState WaveformView::buildViewState (const SampleData::Snapshot
     if (sampleSnap == nullptr)
         return state;
 
-    const int numFrames = sampleSnap->buffer.getNumSamples();
+    const int numFrames = sampleSnap->getNumFrames();
     const int width = getWidth();
     if (numFrames <= 0 || width <= 0)
         return state;
@@ -251,7 +250,7 @@ void WaveformView::rebuildCacheIfNeeded()
     if (key == prevCacheKey)
         return;
 
-    cache.rebuild (sampleSnap->buffer, sampleSnap->peakMipmaps,
+    cache.rebuild (*sampleSnap,
                    view.numFrames, processor.zoom.load(), processor.scroll.load(), view.width);
     prevCacheKey = key;
 }
@@ -849,7 +848,7 @@ void WaveformView::mouseDown (const juce::MouseEvent& e)
         return;
     }
 
-    int samplePos = std::max (0, std::min (pixelToSample (e.x), sampleSnap->buffer.getNumSamples()));
+    int samplePos = std::max (0, std::min (pixelToSample (e.x), sampleSnap->getNumFrames()));
 
     // Shift+click: preview audio from pointer position
     if (e.mods.isShiftDown() && ! sliceDrawMode && ! altModeActive
@@ -1027,7 +1026,7 @@ void WaveformView::mouseDrag (const juce::MouseEvent& e)
         return;
     }
 
-    int samplePos = std::max (0, std::min (pixelToSample (e.x), sampleSnap->buffer.getNumSamples()));
+    int samplePos = std::max (0, std::min (pixelToSample (e.x), sampleSnap->getNumFrames()));
 
     if (dragMode == DrawSlice)
     {
@@ -1056,7 +1055,7 @@ void WaveformView::mouseDrag (const juce::MouseEvent& e)
     {
         const auto& s = ui.slices[(size_t) dragSliceIdx];
         if (processor.snapToZeroCrossing.load())
-            samplePos = AudioAnalysis::findNearestZeroCrossing (sampleSnap->buffer, samplePos);
+            samplePos = SampleData::findNearestZeroCrossing (*sampleSnap, samplePos);
         if (const auto* owner = findSessionSampleById (sampleSnap, s.sampleId))
             samplePos = juce::jlimit (owner->startFrame, dragPreviewEnd - kMinSliceLengthSamples, samplePos);
         dragPreviewStart = std::min (samplePos, dragPreviewEnd - kMinSliceLengthSamples);
@@ -1065,7 +1064,7 @@ void WaveformView::mouseDrag (const juce::MouseEvent& e)
     {
         const auto& s = ui.slices[(size_t) dragSliceIdx];
         if (processor.snapToZeroCrossing.load())
-            samplePos = AudioAnalysis::findNearestZeroCrossing (sampleSnap->buffer, samplePos);
+            samplePos = SampleData::findNearestZeroCrossing (*sampleSnap, samplePos);
         if (const auto* owner = findSessionSampleById (sampleSnap, s.sampleId))
             samplePos = juce::jlimit (dragPreviewStart + kMinSliceLengthSamples, owner->startFrame + owner->numFrames, samplePos);
         dragPreviewEnd = std::max (samplePos, dragPreviewStart + kMinSliceLengthSamples);
@@ -1074,14 +1073,14 @@ void WaveformView::mouseDrag (const juce::MouseEvent& e)
     {
         const auto& s = ui.slices[(size_t) dragSliceIdx];
         if (processor.snapToZeroCrossing.load())
-            samplePos = AudioAnalysis::findNearestZeroCrossing (sampleSnap->buffer, samplePos);
+            samplePos = SampleData::findNearestZeroCrossing (*sampleSnap, samplePos);
         dragLoopPreviewStart = juce::jlimit (s.startSample, dragLoopPreviewEnd - 1, samplePos);
     }
     else if (dragMode == DragLoopRight && dragSliceIdx >= 0 && dragSliceIdx < ui.numSlices)
     {
         const auto& s = ui.slices[(size_t) dragSliceIdx];
         if (processor.snapToZeroCrossing.load())
-            samplePos = AudioAnalysis::findNearestZeroCrossing (sampleSnap->buffer, samplePos);
+            samplePos = SampleData::findNearestZeroCrossing (*sampleSnap, samplePos);
         dragLoopPreviewEnd = juce::jlimit (dragLoopPreviewStart + 1, s.endSample, samplePos);
     }
     else if (dragMode == MoveSlice && dragSliceIdx >= 0)
@@ -1093,7 +1092,7 @@ void WaveformView::mouseDrag (const juce::MouseEvent& e)
 
         // Clamp to sample bounds
         const int minStart = owner != nullptr ? owner->startFrame : 0;
-        const int maxEnd = owner != nullptr ? owner->startFrame + owner->numFrames : sampleSnap->buffer.getNumSamples();
+        const int maxEnd = owner != nullptr ? owner->startFrame + owner->numFrames : sampleSnap->getNumFrames();
         if (newStart < minStart) { newStart = minStart; newEnd = minStart + dragSliceLen; }
         if (newEnd > maxEnd) { newEnd = maxEnd; newStart = maxEnd - dragSliceLen; }
 
@@ -1118,7 +1117,7 @@ void WaveformView::mouseDrag (const juce::MouseEvent& e)
 
     if (dragMode == DuplicateSlice && dragSliceIdx >= 0)
     {
-        int maxLen   = sampleSnap->buffer.getNumSamples();
+        int maxLen   = sampleSnap->getNumFrames();
         int newStart = juce::jlimit (0, maxLen - dragSliceLen, samplePos - dragOffset);
         ghostStart   = newStart;
         ghostEnd     = newStart + dragSliceLen;
@@ -1149,7 +1148,7 @@ void WaveformView::mouseUp (const juce::MouseEvent& e)
     if (dragMode == DrawSlice)
     {
         const bool altStillDown = e.mods.isAltDown();
-        const int maxFrames = sampleSnap ? sampleSnap->buffer.getNumSamples() : 0;
+        const int maxFrames = sampleSnap ? sampleSnap->getNumFrames() : 0;
         int endPos = std::max (0, std::min (pixelToSample (e.x), maxFrames));
         if (sampleSnap != nullptr && ! sampleSnap->sessionSamples.empty())
         {
@@ -1168,8 +1167,8 @@ void WaveformView::mouseUp (const juce::MouseEvent& e)
         }
         if (sampleSnap != nullptr && processor.snapToZeroCrossing.load())
         {
-            drawStart = AudioAnalysis::findNearestZeroCrossing (sampleSnap->buffer, drawStart);
-            endPos = AudioAnalysis::findNearestZeroCrossing (sampleSnap->buffer, endPos);
+            drawStart = SampleData::findNearestZeroCrossing (*sampleSnap, drawStart);
+            endPos = SampleData::findNearestZeroCrossing (*sampleSnap, endPos);
         }
         if (std::abs (endPos - drawStart) >= kMinSliceLengthSamples)
         {
@@ -1239,7 +1238,7 @@ void WaveformView::mouseUp (const juce::MouseEvent& e)
     {
         if (sampleSnap != nullptr && processor.snapToZeroCrossing.load())
         {
-            ghostStart = AudioAnalysis::findNearestZeroCrossing (sampleSnap->buffer, ghostStart);
+            ghostStart = SampleData::findNearestZeroCrossing (*sampleSnap, ghostStart);
             ghostEnd   = ghostStart + dragSliceLen;
         }
         if (sampleSnap != nullptr && dragSliceIdx >= 0 && dragSliceIdx < ui.numSlices)
@@ -0,0 +1,160 @@
+#include "src/audio/DeferredReclaimer.h"
+#include "src/audio/SampleData.h"
+#include <functional>
+
+namespace
+{
+// Records which thread destroyed it, and counts destructions.
+struct Tracked
+{
+    Tracked (std::atomic<int>& countIn, std::atomic<juce::Thread::ThreadID>* freedOnIn = nullptr)
+        : count (countIn), freedOn (freedOnIn) {}
+
+    ~Tracked()
+    {
+        if (freedOn != nullptr)
+            freedOn->store (juce::Thread::getCurrentThreadId());
+        count.fetch_add (1);
+    }
+
+    std::atomic<int>& count;
+    std::atomic<juce::Thread::ThreadID>* freedOn;
+};
+
+// Parks the reclaimer thread inside its destructor until released.
+struct Blocker
+{
+    Blocker (juce::WaitableEvent& enteredIn, juce::WaitableEvent& releaseIn)
+        : entered (enteredIn), release (releaseIn) {}
+
+    ~Blocker()
+    {
+        entered.signal();
+        release.wait (-1);
+    }
+
+    juce::WaitableEvent& entered;
+    juce::WaitableEvent& release;
+};
+
+bool waitUntil (const std::function<bool()>& done, int timeoutMs = 2000)
+{
+    const auto deadline = juce::Time::getMillisecondCounter() + (juce::uint32) timeoutMs;
+    while (! done())
+    {
+        if (juce::Time::getMillisecondCounter() > deadline)
+            return false;
+        juce::Thread::sleep (1);
+    }
+    return true;
+}
+
+bool countersBalance (const DeferredReclaimer& r)
+{
+    return r.getNumRetired() == r.getNumReclaimed() + r.getNumFreedInline();
+}
+
+std::unique_ptr<SampleData::DecodedSample> makeSample (int numFrames)
+{
+    auto decoded = std::make_unique<SampleData::DecodedSample>();
+    decoded->buffer.setSize (2, numFrames);
+    decoded->buffer.clear();
+    decoded->decodedNumFrames = numFrames;
+    decoded->decodedSampleRate = 44100.0;
+    decoded->sourceNumFrames = numFrames;
+    decoded->sourceSampleRate = 44100.0;
+    return decoded;
+}
+} // namespace
+
+class DeferredReclaimerTests : public juce::UnitTest
+{
+public:
+    DeferredReclaimerTests() : juce::UnitTest ("Deferred reclaimer", "Intersect") {}
+
+    void runTest() override
+    {
+        beginTest ("retired objects are freed on the reclaimer thread");
+        {
+            DeferredReclaimer reclaimer;
+            std::atomic<int> destroyed { 0 };
+            std::atomic<juce::Thread::ThreadID> freedOn { nullptr };
+
+            reclaimer.retire (std::make_unique<Tracked> (destroyed, &freedOn));
+            expectEquals (destroyed.load(), 0, "retire() freed the object inline");
+
+            expect (waitUntil ([&] { return destroyed.load() == 1; }), "object was never reclaimed");
+            expect (freedOn.load() != juce::Thread::getCurrentThreadId(), "object was freed on the retiring thread");
+            expectEquals ((int) reclaimer.getNumRetired(), 1);
+            expectEquals ((int) reclaimer.getNumReclaimed(), 1);
+            expectEquals ((int) reclaimer.getNumFreedInline(), 0);
+        }
+
+        beginTest ("a shared object outlives the retired reference");
+        {
+            DeferredReclaimer reclaimer;
+            std::atomic<int> destroyed { 0 };
+
+            auto held = std::make_shared<Tracked> (destroyed);
+            reclaimer.retire (std::shared_ptr<Tracked> (held));
+            expect (waitUntil ([&] { return reclaimer.getNumReclaimed() == 1; }));
+            expectEquals (destroyed.load(), 0, "reclaiming a shared reference destroyed a live object");
+            expectEquals ((int) held.use_count(), 1);
+
+            reclaimer.retire (std::move (held));
+            expect (waitUntil ([&] { return destroyed.load() == 1; }), "last reference was never reclaimed");
+            expect (countersBalance (reclaimer));
+        }
+
+        beginTest ("a full queue frees inline and the counters still balance");
+        {
+            DeferredReclaimer reclaimer;
+            juce::WaitableEvent entered, release;
+            std::atomic<int> destroyed { 0 };
+
+            reclaimer.retire (std::make_unique<Blocker> (entered, release));
+            expect (entered.wait (2000), "reclaimer thread never picked up the blocker");
+
+            // The blocker's cell is free again, so exactly kCapacity fit.
+            constexpr int kOverflow = 10;
+            for (int i = 0; i < DeferredReclaimer::kCapacity + kOverflow; ++i)
+                reclaimer.retire (std::make_unique<Tracked> (destroyed));
+
+            expectEquals ((int) reclaimer.getNumFreedInline(), kOverflow);
+            expectEquals (destroyed.load(), kOverflow);
+            expectEquals ((int) reclaimer.getNumRetired(), DeferredReclaimer::kCapacity + kOverflow + 1);
+
+            release.signal();
+            reclaimer.reclaimNow();
+            expect (waitUntil ([&] { return destroyed.load() == DeferredReclaimer::kCapacity + kOverflow; }));
+            expect (waitUntil ([&] { return countersBalance (reclaimer); }));
+            expectEquals ((int) reclaimer.getNumReclaimed(), DeferredReclaimer::kCapacity + 1);
+        }
+
+        beginTest ("SampleData retires the sample it replaces");
+        {
+            DeferredReclaimer reclaimer;
+            SampleData sample;
+            sample.setReclaimer (&reclaimer);
+
+            sample.applyDecodedSample (makeSample (1000));
+            std::weak_ptr<const SampleData::DecodedSample> first = sample.getSnapshot();
+            expectEquals ((int) reclaimer.getNumRetired(), 0);
+
+            sample.applyDecodedSample (makeSample (2000));
+            expectEquals ((int) reclaimer.getNumRetired(), 1);
+            expect (waitUntil ([&] { return first.expired(); }), "replaced sample was never freed");
+
+            // A UI-held snapshot keeps the sample alive past clear().
+            auto second = sample.getSnapshot();
+            sample.clear();
+            expectEquals ((int) reclaimer.getNumRetired(), 2);
+            expect (waitUntil ([&] { return reclaimer.getNumReclaimed() == 2; }));
+            expectEquals (second->decodedNumFrames, 2000);
+            expectEquals ((int) second.use_count(), 1);
+            expect (countersBalance (reclaimer));
+        }
+    }
+};
+
+static DeferredReclaimerTests deferredReclaimerTests;
@@ -0,0 +1,15 @@
+#include <juce_core/juce_core.h>
+
+// Runs every juce::UnitTest linked into the app; exits non-zero on any failure.
+int main()
+{
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure (false);
+    runner.runAllTests();
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult (i)->failures;
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+#include "src/audio/AudioAnalysis.h"
+#include <random>
+
+namespace
+{
+// The nth_element median the sliding window replaced.
+std::vector<float> referenceMedian (const std::vector<float>& odf, int radius)
+{
+    std::vector<float> medians (odf.size());
+    std::vector<float> window;
+    for (size_t i = 0; i < odf.size(); ++i)
+    {
+        const size_t lo = i > (size_t) radius ? i - (size_t) radius : 0;
+        const size_t hi = std::min (i + (size_t) radius, odf.size() - 1);
+
+        window.assign (odf.begin() + (ptrdiff_t) lo, odf.begin() + (ptrdiff_t) hi + 1);
+        const size_t mid = window.size() / 2;
+        std::nth_element (window.begin(), window.begin() + (ptrdiff_t) mid, window.end());
+        medians[i] = window[mid];
+    }
+    return medians;
+}
+
+// The O(k^2) strongest-first filter the ordered set replaced.
+std::vector<int> referenceKeepApart (std::vector<AudioAnalysis::OnsetCandidate> candidates, int minDistance)
+{
+    std::sort (candidates.begin(), candidates.end(),
+               [] (const auto& a, const auto& b) { return a.strength > b.strength; });
+
+    std::vector<int> kept;
+    for (const auto& c : candidates)
+    {
+        bool tooClose = false;
+        for (int k : kept)
+        {
+            if (std::abs (c.samplePos - k) < minDistance)
+            {
+                tooClose = true;
+                break;
+            }
+        }
+        if (! tooClose)
+            kept.push_back (c.samplePos);
+    }
+
+    std::sort (kept.begin(), kept.end());
+    return kept;
+}
+
+// Values from a small set, so windows are full of repeats.
+std::vector<float> makeOdf (juce::Random& rng, int size, int numLevels)
+{
+    std::vector<float> odf ((size_t) size);
+    for (auto& v : odf)
+        v = (float) rng.nextInt (numLevels) * 0.25f;
+    return odf;
+}
+} // namespace
+
+class TransientPickTests : public juce::UnitTest
+{
+public:
+    TransientPickTests() : juce::UnitTest ("Transient picking", "Intersect") {}
+
+    void runTest() override
+    {
+        juce::Random rng (42);
+
+        beginTest ("sliding median matches nth_element");
+        for (int size : { 1, 2, 5, 10, 11, 20, 21, 22, 100, 2000 })
+        {
+            for (int numLevels : { 1, 3, 1000 })
+            {
+                const auto odf = makeOdf (rng, size, numLevels);
+                for (int radius : { 0, 1, 10 })
+                    expect (AudioAnalysis::movingMedian (odf, radius) == referenceMedian (odf, radius),
+                            "size " + juce::String (size) + ", levels " + juce::String (numLevels)
+                                + ", radius " + juce::String (radius));
+            }
+        }
+
+        beginTest ("min-distance filter matches the pairwise scan");
+        for (int trial = 0; trial < 200; ++trial)
+        {
+            const int numCandidates = rng.nextInt (300);
+            const int span = 1 + rng.nextInt (50000);
+            const int minDistance = 1 + rng.nextInt (4000);
+
+            // Distinct strengths, so the strongest-first order is fully defined;
+            // positions may repeat.
+            std::vector<AudioAnalysis::OnsetCandidate> candidates;
+            for (int i = 0; i < numCandidates; ++i)
+                candidates.push_back ({ rng.nextInt (span), (float) i });
+            std::shuffle (candidates.begin(), candidates.end(), std::mt19937 ((unsigned) trial));
+
+            expect (AudioAnalysis::keepStrongestApart (candidates, minDistance)
+                        == referenceKeepApart (candidates, minDistance),
+                    "trial " + juce::String (trial));
+        }
+    }
+};
+
+static TransientPickTests transientPickTests;
@@ -0,0 +1,114 @@
+#include "src/audio/AudioAnalysis.h"
+#include "src/audio/ZeroCrossingIndex.h"
+
+namespace
+{
+constexpr int kPageSize = 1 << ZeroCrossingIndex::kPageShift;
+
+// Noise broken up by stretches with no crossings at all (digital silence, a
+// constant offset, channels that cancel exactly), one of them covering a
+// whole page, so the index has empty pages and long gaps.
+juce::AudioBuffer<float> makeSignal (juce::Random& rng, int numFrames)
+{
+    juce::AudioBuffer<float> buffer (2, numFrames);
+    auto* L = buffer.getWritePointer (0);
+    auto* R = buffer.getWritePointer (1);
+
+    for (int i = 0; i < numFrames; ++i)
+    {
+        L[i] = rng.nextFloat() - 0.5f;
+        R[i] = rng.nextFloat() - 0.5f;
+    }
+
+    const auto fill = [&] (int start, int end, float l, float r)
+    {
+        for (int i = juce::jmax (0, start); i < juce::jmin (numFrames, end); ++i)
+        {
+            L[i] = l;
+            R[i] = r;
+        }
+    };
+
+    fill (kPageSize - 300, 2 * kPageSize + 300, 0.0f, 0.0f);
+    fill (2 * kPageSize + 5000, 2 * kPageSize + 9000, -0.25f, -0.1f);
+    fill (3 * kPageSize - 40, 3 * kPageSize + 40, 0.3f, -0.3f);
+    fill (numFrames - 700, numFrames, -0.0f, 0.0f);
+
+    // Isolated exact zeros, which count as non-negative.
+    for (int k = 0; k < 2000 && numFrames > 0; ++k)
+    {
+        const int i = rng.nextInt (numFrames);
+        L[i] = R[i] = 0.0f;
+    }
+
+    return buffer;
+}
+} // namespace
+
+class ZeroCrossingIndexTests : public juce::UnitTest
+{
+public:
+    ZeroCrossingIndexTests() : juce::UnitTest ("Zero-crossing index", "Intersect") {}
+
+    void runTest() override
+    {
+        juce::Random rng (7);
+
+        beginTest ("findNearest matches the linear scan");
+        {
+            const int numFrames = 3 * kPageSize + 12345;
+            const auto buffer = makeSignal (rng, numFrames);
+            checkAgainstScan (rng, buffer);
+        }
+
+        beginTest ("findNearest matches the linear scan on short and empty signals");
+        for (int numFrames : { 0, 1, 2, 63, 64, 65, 8192, 8193, kPageSize, kPageSize + 1 })
+        {
+            const auto buffer = makeSignal (rng, numFrames);
+            checkAgainstScan (rng, buffer);
+        }
+    }
+
+private:
+    void checkAgainstScan (juce::Random& rng, const juce::AudioBuffer<float>& buffer)
+    {
+        const int numFrames = buffer.getNumSamples();
+        const auto index = ZeroCrossingIndex::build (numFrames, [&buffer] (int channel, int start, int count, float* dest)
+        {
+            std::copy_n (buffer.getReadPointer (channel, start), count, dest);
+        });
+
+        std::vector<int> positions { -1, 0, 1, 2, numFrames - 2, numFrames - 1, numFrames };
+        for (int page = 1; page * kPageSize <= numFrames; ++page)
+            for (int offset : { -2, -1, 0, 1, 2 })
+                positions.push_back (page * kPageSize + offset);
+
+        std::vector<int> randomPositions;
+        for (int k = 0; k < 300 && numFrames > 0; ++k)
+            randomPositions.push_back (rng.nextInt (numFrames));
+
+        const auto check = [&] (int pos, int range)
+        {
+            const int expected = AudioAnalysis::findNearestZeroCrossing (buffer, pos, range);
+            expectEquals (index->findNearest (pos, range), expected,
+                          "frames " + juce::String (numFrames) + ", pos " + juce::String (pos)
+                              + ", range " + juce::String (range));
+        };
+
+        for (int range : { 0, 1, 2, 7, 64, 512, 4000, kPageSize + 100 })
+        {
+            for (int pos : positions)
+                check (pos, range);
+            for (int pos : randomPositions)
+                check (pos, range);
+        }
+
+        // Whole-signal ranges reach across every page; a few positions suffice.
+        for (int k = 0; k < 10 && k < (int) randomPositions.size(); ++k)
+            check (randomPositions[(size_t) k], 4 * kPageSize);
+        for (int pos : positions)
+            check (pos, 4 * kPageSize);
+    }
+};
+
+static ZeroCrossingIndexTests zeroCrossingIndexTests;